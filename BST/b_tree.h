@@ -0,0 +1,463 @@
+#ifndef B_TREE_H
+#define B_TREE_H
+/* Sam Drew ~ 2025
+ * B-Tree implementation in C++
+ * ---
+ *  This is a simple implementation of a B-Tree. Written by me, for my own
+ *  edification in data structures and algorithms and C++.
+ *
+ *  Where a Binary Search Tree Node holds a single value and costs a cache miss
+ *  for every level of the tree, a B-Tree Node holds up to Fanout - 1 values
+ *  in a small contiguous array that is sized to a few cache lines. A search
+ *  scans each Node linearly and then follows one of Fanout children, so a
+ *  lookup touches log_Fanout(n) Nodes instead of log_2(n).
+ *
+ *  Class templating is used to allow the creation of B-Trees of any object
+ *  type. This version doesn't provide deduction guides so will only compile
+ *  with C++20 or newer.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "node_arena.h"
+
+namespace sjd {
+
+// Enough children that a Node's values fill roughly four cache lines.
+template <typename T>
+constexpr std::size_t defaultBTreeFanout() {
+    std::size_t fanout {(4 * 64) / sizeof(T)};
+    fanout = std::max<std::size_t>(fanout, 4);
+    return std::min<std::size_t>(fanout + (fanout % 2), 256);
+}
+
+/* B-Tree template class.
+ *
+ *  Has the same interface as sjd::BinarySearchTree. Every Node other than the
+ *  root holds between Fanout/2 - 1 and Fanout - 1 values, and all leaves sit
+ *  at the same depth, so the tree is always balanced.
+ *  Objects must be of a type that is comparable (Can use the comparison
+ *  operator <) or you will recieve a compiler error. Two values are the same
+ *  when neither is less than the other, and T needn't be default
+ *  constructible.
+ *  Example:
+ *      sjd::BTree<int> myTree {};          // myTree: []
+ *      myTree.insert(2);                   // myTree: [2]
+ *      myTree.insert(1);                   // myTree: [1 2]
+ *      myTree.contains(1);                 // true
+ *
+ *      sjd::BTree<int, 4> mySmallTree {};  // at most 3 values per Node
+ *
+ *  NOTE: A sorted set like this is already implemented in the standard C++
+ *  library as the std::set container. Prefer to use the standard container
+ *  for all collaborative work.
+ */
+template <typename T, std::size_t Fanout = defaultBTreeFanout<T>()>
+class BTree {
+    static_assert(Fanout >= 4 && Fanout % 2 == 0, "Fanout must be even and at least 4");
+    static_assert(Fanout <= 256, "Node counts are stored in a uint16_t");
+
+public:
+    static constexpr std::size_t s_minDegree {Fanout / 2};
+    static constexpr std::size_t s_maxValues {Fanout - 1};
+
+    /* The value slots are raw storage: only the first count hold a live
+     * value, so an empty slot costs nothing to create or destroy.
+     */
+    struct alignas(64) Node {
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        Slot slots[s_maxValues];
+        std::array<Node*, Fanout> children {};
+        std::uint16_t count {0};        // number of values in use
+        bool leaf {true};
+
+        Node() {}                       // leaves the slots raw
+        ~Node() {
+            for (std::size_t i {0}; i < count; ++i) {std::destroy_at(&value(i));}
+        }
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
+
+        T* address(std::size_t i) { return reinterpret_cast<T*>(slots[i].storage); }
+        T& value(std::size_t i) { return *std::launder(address(i)); }
+        const T& value(std::size_t i) const { return *std::launder(reinterpret_cast<const T*>(slots[i].storage)); }
+    };
+
+    BTree()
+    : m_root {}
+    , m_size {0}
+    {
+    }
+
+    ~BTree() { __clear(); }
+
+    // Copy constructor
+    BTree(const BTree& source)
+    : m_root {}
+    , m_size {0}
+    {
+        deepCopy(source);
+    }
+
+    void deepCopy(const BTree& source) {
+        __clear();
+        m_root = __r_clone(source.m_root);
+        m_size = source.m_size;
+    }
+
+    BTree& operator=(const BTree& source) {
+        if (this != &source) {
+            deepCopy(source);
+        }
+        return *this;
+    }
+
+    Node* root() const { return m_root; }
+    std::size_t size() const { return m_size; }
+
+    bool insert(const T& value) {
+        if (!m_root) {
+            m_root = m_nodes.create();
+        }
+        if (m_root -> count == s_maxValues) {
+            // full root. Split it and grow the tree upwards by one level
+            Node* newRoot {m_nodes.create()};
+            newRoot -> leaf = false;
+            newRoot -> children[0] = m_root;
+            m_root = newRoot;
+            __splitChild(newRoot, 0);
+        }
+        // Split any full Node on the way down so there is always room to
+        // push a value up into the parent.
+        Node* node {m_root};
+        while (true) {
+            std::size_t index {__lowerBound(node, value)};
+            if (index < node -> count && !(value < node -> value(index))) {return false;}
+            if (node -> leaf) {
+                __insertValue(node, index, value);
+                ++m_size;
+                return true;
+            }
+            if (node -> children[index] -> count == s_maxValues) {
+                __splitChild(node, index);
+                const T& median {node -> value(index)};
+                if (median < value) {++index;}
+                else if (!(value < median)) {return false;}
+            }
+            node = node -> children[index];
+        }
+    }
+
+    bool contains(const T& value) const {
+        Node* node {m_root};
+        while (node) {
+            std::size_t index {__lowerBound(node, value)};
+            if (index < node -> count && !(value < node -> value(index))) {return true;}
+            if (node -> leaf) {return false;}
+            node = node -> children[index];
+        }
+        return false;
+    }
+
+    /* Removes the value from the tree in a single pass down from the root.
+     * Before stepping into a child the child is topped up to at least
+     * s_minDegree values, by borrowing from a sibling or merging with one, so
+     * a value can always be taken out of it without underflowing.
+     * Returns false if the value wasn't in the tree.
+     */
+    bool remove(const T& value) {
+        if (!m_root) {return false;}
+        Node* node {m_root};
+        T target {value};
+        bool removed {false};
+        while (true) {
+            std::size_t index {__lowerBound(node, target)};
+            bool found {index < node -> count && !(target < node -> value(index))};
+            if (found && node -> leaf) {
+                __eraseValue(node, index);
+                --m_size;
+                removed = true;
+                break;
+            }
+            if (found) {
+                Node* left {node -> children[index]};
+                Node* right {node -> children[index + 1]};
+                if (left -> count >= s_minDegree) {
+                    // replace with the predecessor and remove that instead
+                    target = __max(left);
+                    node -> value(index) = target;
+                    node = left;
+                }
+                else if (right -> count >= s_minDegree) {
+                    // replace with the successor and remove that instead
+                    target = __min(right);
+                    node -> value(index) = target;
+                    node = right;
+                }
+                else {
+                    __mergeChildren(node, index);
+                    node = left;
+                }
+                continue;
+            }
+            if (node -> leaf) {break;}      // not in the tree
+            if (node -> children[index] -> count < s_minDegree) {
+                index = __fillChild(node, index);
+            }
+            node = node -> children[index];
+        }
+        // the root is the only Node allowed to run out of values
+        if (m_root -> count == 0) {
+            Node* oldRoot {m_root};
+            m_root = m_root -> leaf ? nullptr : m_root -> children[0];
+            m_nodes.destroy(oldRoot);
+        }
+        return removed;
+    }
+
+    std::vector<T> dfsInOrder() const {
+        std::vector<T> results {};
+        results.reserve(m_size);
+        __r_traverseDfsInOrder(m_root, results);
+        return results;
+    }
+
+    friend std::ostream& operator<< (std::ostream& out, const BTree& tree) {
+        out << "BTree[ ";
+        for (const T& value : tree.dfsInOrder()) {
+            out << value << " ";
+        }
+        out << "]";
+        return out;
+    }
+
+private:
+    Node* m_root {nullptr};
+    std::size_t m_size {};
+    NodeArena<Node> m_nodes {};
+
+    /* Index of the first value in the Node that is not less than the given
+     * value. Arithmetic values are counted without an early exit so the loop
+     * has no data dependent branch and can be vectorised.
+     */
+    static std::size_t __lowerBound(const Node* node, const T& value) {
+        std::size_t index {0};
+        if constexpr (std::is_arithmetic_v<T>) {
+            for (std::size_t i {0}; i < node -> count; ++i) {
+                index += static_cast<std::size_t>(node -> value(i) < value);
+            }
+        }
+        else {
+            while (index < node -> count && node -> value(index) < value) {++index;}
+        }
+        return index;
+    }
+
+    static T __min(const Node* node) {
+        while (!(node -> leaf)) {node = node -> children[0];}
+        return node -> value(0);
+    }
+
+    static T __max(const Node* node) {
+        while (!(node -> leaf)) {node = node -> children[node -> count];}
+        return node -> value(node -> count - 1u);
+    }
+
+    /* Builds a value into the slot at index, moving the values from index on
+     * up one slot. The Node must not be full. The new value is built before
+     * anything moves in case it is one of the values that will.
+     */
+    template <typename V>
+    static void __insertValue(Node* node, std::size_t index, V&& value) {
+        if (index == node -> count) {
+            std::construct_at(node -> address(index), std::forward<V>(value));
+        }
+        else {
+            T temp(std::forward<V>(value));
+            for (std::size_t i {node -> count}; i > index; --i) {
+                __relocate(node, i - 1, node, i);
+            }
+            std::construct_at(node -> address(index), std::move(temp));
+        }
+        ++(node -> count);
+    }
+
+    static void __eraseValue(Node* node, std::size_t index) {
+        std::destroy_at(&node -> value(index));
+        __closeGap(node, index);
+    }
+
+    // Moves the values after the raw slot at index down to fill it.
+    static void __closeGap(Node* node, std::size_t index) {
+        for (std::size_t i {index + 1}; i < node -> count; ++i) {
+            __relocate(node, i, node, i - 1);
+        }
+        --(node -> count);
+    }
+
+    // Moves the value in one slot into a raw slot, leaving the first raw.
+    static void __relocate(Node* from, std::size_t fromIndex, Node* to, std::size_t toIndex) {
+        std::construct_at(to -> address(toIndex), std::move(from -> value(fromIndex)));
+        std::destroy_at(&from -> value(fromIndex));
+    }
+
+    /* Splits the full child at the given index in two and lifts its median
+     * value into the parent, which must not be full.
+     *
+     *      [ .. x .. ]              [ .. x  m .. ]
+     *          |          split         |   \
+     *     [a b m c d]     ---->      [a b] [c d]
+     */
+    void __splitChild(Node* parent, std::size_t index) {
+        Node* child {parent -> children[index]};
+        Node* sibling {m_nodes.create()};
+        sibling -> leaf = child -> leaf;
+        for (std::size_t i {s_minDegree}; i < s_maxValues; ++i) {
+            __relocate(child, i, sibling, i - s_minDegree);
+            ++(sibling -> count);
+        }
+        if (!(child -> leaf)) {
+            std::copy(child -> children.begin() + s_minDegree,
+                      child -> children.end(),
+                      sibling -> children.begin());
+        }
+        std::copy_backward(parent -> children.begin() + index + 1,
+                           parent -> children.begin() + parent -> count + 1,
+                           parent -> children.begin() + parent -> count + 2);
+        parent -> children[index + 1] = sibling;
+        __insertValue(parent, index, std::move(child -> value(s_minDegree - 1)));
+        std::destroy_at(&child -> value(s_minDegree - 1));
+        child -> count = static_cast<std::uint16_t>(s_minDegree - 1);
+    }
+
+    /* Folds the separating value at the given index and the child to its
+     * right into the child to its left. Both children must be minimal.
+     */
+    void __mergeChildren(Node* parent, std::size_t index) {
+        Node* left {parent -> children[index]};
+        Node* right {parent -> children[index + 1]};
+        if (!(left -> leaf)) {
+            std::copy(right -> children.begin(),
+                      right -> children.begin() + right -> count + 1,
+                      left -> children.begin() + left -> count + 1);
+        }
+        __relocate(parent, index, left, left -> count);
+        for (std::size_t i {0}; i < right -> count; ++i) {
+            __relocate(right, i, left, left -> count + 1u + i);
+        }
+        left -> count = static_cast<std::uint16_t>(left -> count + right -> count + 1);
+        right -> count = 0;
+
+        __closeGap(parent, index);
+        std::copy(parent -> children.begin() + index + 2,
+                  parent -> children.begin() + parent -> count + 2,
+                  parent -> children.begin() + index + 1);
+        m_nodes.destroy(right);
+    }
+
+    /* Makes sure the child at the given index has at least s_minDegree values
+     * by rotating one in through the parent from a sibling that can spare it,
+     * or else merging it with a sibling. Returns the index of the child that
+     * now covers the same range of values.
+     */
+    std::size_t __fillChild(Node* parent, std::size_t index) {
+        Node* child {parent -> children[index]};
+        if (index > 0 && parent -> children[index - 1] -> count >= s_minDegree) {
+            Node* left {parent -> children[index - 1]};
+            for (std::size_t i {child -> count}; i > 0; --i) {
+                __relocate(child, i - 1, child, i);
+            }
+            __relocate(parent, index - 1, child, 0);
+            if (!(child -> leaf)) {
+                std::copy_backward(child -> children.begin(),
+                                   child -> children.begin() + child -> count + 1,
+                                   child -> children.begin() + child -> count + 2);
+                child -> children[0] = left -> children[left -> count];
+            }
+            __relocate(left, left -> count - 1u, parent, index - 1);
+            --(left -> count);
+            ++(child -> count);
+            return index;
+        }
+        if (index < parent -> count && parent -> children[index + 1] -> count >= s_minDegree) {
+            Node* right {parent -> children[index + 1]};
+            __relocate(parent, index, child, child -> count);
+            if (!(child -> leaf)) {
+                child -> children[child -> count + 1u] = right -> children[0];
+                std::copy(right -> children.begin() + 1,
+                          right -> children.begin() + right -> count + 1,
+                          right -> children.begin());
+            }
+            __relocate(right, 0, parent, index);
+            __closeGap(right, 0);
+            ++(child -> count);
+            return index;
+        }
+        if (index < parent -> count) {
+            __mergeChildren(parent, index);
+            return index;
+        }
+        __mergeChildren(parent, index - 1);
+        return index - 1;
+    }
+
+    // Recursively steps through the tree. Depth is only log_Fanout(n).
+    void __r_traverseDfsInOrder(const Node* node, std::vector<T>& arrayOut) const {
+        if (!node) {return;}
+        for (std::size_t i {0}; i < node -> count; ++i) {
+            if (!(node -> leaf)) {__r_traverseDfsInOrder(node -> children[i], arrayOut);}
+            arrayOut.push_back(node -> value(i));
+        }
+        if (!(node -> leaf)) {__r_traverseDfsInOrder(node -> children[node -> count], arrayOut);}
+    }
+
+    Node* __r_clone(const Node* sourceNode) {
+        if (!sourceNode) {return nullptr;}
+        Node* node {m_nodes.create()};
+        for (std::size_t i {0}; i < sourceNode -> count; ++i) {
+            std::construct_at(node -> address(i), sourceNode -> value(i));
+            ++(node -> count);
+        }
+        node -> leaf = sourceNode -> leaf;
+        if (!(node -> leaf)) {
+            for (std::size_t i {0}; i <= node -> count; ++i) {
+                node -> children[i] = __r_clone(sourceNode -> children[i]);
+            }
+        }
+        return node;
+    }
+
+    void __r_destroy(Node* node) {
+        if (!node) {return;}
+        if (!(node -> leaf)) {
+            for (std::size_t i {0}; i <= node -> count; ++i) {
+                __r_destroy(node -> children[i]);
+            }
+        }
+        m_nodes.destroy(node);
+    }
+
+    // Trivially destructible values need no walk; the arena is simply dropped.
+    void __clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            __r_destroy(m_root);
+        }
+        m_nodes.clear();
+        m_root = nullptr;
+        m_size = 0;
+    }
+};
+
+} // end namespace sjd
+#endif
@@ -0,0 +1,167 @@
+#ifndef BINARY_SEARCH_MAP_H
+#define BINARY_SEARCH_MAP_H
+/* Sam Drew ~ 2025
+ * Binary Search Map implementation in C++
+ * ---
+ *  A sorted key/value map built on sjd::BinarySearchTree. Written by me, for
+ *  my own edification in data structures and algorithms and C++.
+ *
+ *  Each Node of the underlying tree holds an Entry: a key, which orders the
+ *  tree, and a value that rides along with it. Entries are compared by key
+ *  alone, so lookups take a bare key and never build an Entry. Inserting
+ *  descends the tree once: the descent that finds the key is the one that
+ *  remembers where a new Node would hang, and the value is only built, in
+ *  place inside the new Node, once the key is known to be missing.
+ *
+ *  Class templating is used to allow the creation of maps of any key and
+ *  value types. This version doesn't provide deduction guides so will only
+ *  compile with C++20 or newer.
+ */
+
+#include <functional>
+#include <iostream>
+#include <utility>
+#include "binary_search_tree.h"
+
+namespace sjd {
+
+/* Binary Search Map template class.
+ *
+ *  Keys are ordered with Compare, which defaults to std::less<K>; a
+ *  transparent comparator lets every lookup take any type it can compare
+ *  against K. The map is AVL balanced unless another policy is given.
+ *  Iterators visit the entries in key order and act as handles: it -> key is
+ *  read-only and it -> value can be changed in place. Entries never move once
+ *  built, so a handle stays valid until its own entry is removed, whatever
+ *  else is inserted or removed in the meantime.
+ *  Example:
+ *      sjd::BinarySearchMap<int, std::string> myMap {};  // myMap: []
+ *      myMap.try_emplace(2, 3, 'b');           // myMap: [2:bbb]
+ *      myMap[1] = "a";                         // myMap: [1:a 2:bbb]
+ *      myMap.insert_or_assign(2, "c");         // myMap: [1:a 2:c]
+ *      auto it {myMap.find(1)};                // it -> value == "a"
+ *
+ *  NOTE: A Class like this is already implemented in the standard C++ library
+ *  as the std::map container. Prefer to use the standard container for all
+ *  collaborative work.
+ */
+template <typename K, typename V, typename Compare = std::less<K>, typename Balance = AVLBalanced>
+class BinarySearchMap {
+public:
+    struct Entry {
+        K key {};
+        mutable V value {};     // the tree is only ordered by key
+    };
+
+    // Orders Entries by key and compares them against bare keys.
+    struct EntryCompare {
+        using is_transparent = void;
+        [[no_unique_address]] Compare compare {};
+
+        bool operator()(const Entry& a, const Entry& b) const { return compare(a.key, b.key); }
+
+        template <typename L>
+        bool operator()(const Entry& a, const L& b) const { return compare(a.key, b); }
+
+        template <typename L>
+        bool operator()(const L& a, const Entry& b) const { return compare(a, b.key); }
+    };
+
+    using Tree = BinarySearchTree<Entry, EntryCompare, Balance>;
+    using iterator = typename Tree::const_iterator;
+    using const_iterator = typename Tree::const_iterator;
+
+    BinarySearchMap() = default;
+
+    explicit BinarySearchMap(const Compare& compare)
+    : m_tree {EntryCompare{compare}}
+    {
+    }
+
+    std::size_t size() const { return m_tree.size(); }
+
+    iterator begin() const { return m_tree.begin(); }
+    iterator end() const { return m_tree.end(); }
+
+    // The underlying tree, e.g. to walk its Nodes.
+    const Tree& tree() const { return m_tree; }
+
+    // Returns a handle to the entry for key, or end() if there isn't one.
+    iterator find(const K& key) const { return m_tree.find(key); }
+
+    template <typename L> requires requires { typename Compare::is_transparent; }
+    iterator find(const L& key) const { return m_tree.find(key); }
+
+    bool contains(const K& key) const { return m_tree.contains(key); }
+
+    template <typename L> requires requires { typename Compare::is_transparent; }
+    bool contains(const L& key) const { return m_tree.contains(key); }
+
+    /* Adds an entry for key with a value built in place from args, unless the
+     * key is already in the map, in which case args are left untouched.
+     * Returns a handle to the entry for key and whether it was added.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        return __tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return __tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /* Adds an entry for key holding value, or assigns value to the existing
+     * entry. Either way the tree is only descended once.
+     * Returns a handle to the entry for key and whether it was added.
+     */
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+        return __insertOrAssign(key, std::forward<M>(value));
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& value) {
+        return __insertOrAssign(std::move(key), std::forward<M>(value));
+    }
+
+    // The value for key, default constructed in place first if it's missing.
+    V& operator[](const K& key) { return try_emplace(key).first -> value; }
+    V& operator[](K&& key) { return try_emplace(std::move(key)).first -> value; }
+
+    // Returns false if there was no entry for key. Only iterators to key's
+    // entry are invalidated.
+    bool remove(const K& key) { return m_tree.remove(key); }
+
+    friend std::ostream& operator<< (std::ostream& out, const BinarySearchMap& map) {
+        out << "BSMap[ ";
+        for (const Entry& entry : map) {
+            out << entry.key << ":" << entry.value << " ";
+        }
+        out << "]";
+        return out;
+    }
+
+private:
+    Tree m_tree {};
+
+    template <typename KeyArg, typename... Args>
+    std::pair<iterator, bool> __tryEmplace(KeyArg&& key, Args&&... args) {
+        auto [node, added] {m_tree.__tryEmplace(key, [&]() -> Entry {
+            return Entry{std::forward<KeyArg>(key), V(std::forward<Args>(args)...)};
+        })};
+        return {iterator{node, &m_tree}, added};
+    }
+
+    template <typename KeyArg, typename M>
+    std::pair<iterator, bool> __insertOrAssign(KeyArg&& key, M&& value) {
+        auto [node, added] {m_tree.__tryEmplace(key, [&]() -> Entry {
+            return Entry{std::forward<KeyArg>(key), V(std::forward<M>(value))};
+        })};
+        if (!added) {node -> value.value = std::forward<M>(value);}
+        return {iterator{node, &m_tree}, added};
+    }
+};
+
+} // end namespace sjd
+#endif
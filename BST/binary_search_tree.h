@@ -9,31 +9,156 @@
  *  object type. This version uses CTAD (Class Type Argument Deduction) 
  *  and doesn't provide deduction guides so will only compile with C++20 or
  *  newer.
+ *
+ *  Nodes are stored in a sjd::NodeArena owned by the tree and linked with raw
+ *  pointers, so walking the tree never touches a reference count.
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <utility>
+#include <type_traits>
 #include <vector>
-#include "../LL/queue.h"
+#include "blocked_bloom_filter.h"
+#include "frozen_set.h"
+#include "node_arena.h"
+#include "ring_buffer.h"
+#include "work_stealing_pool.h"
+
+namespace sjd {
+
+/* Balancing policies for BinarySearchTree.
+ *
+ *  Unbalanced keeps the original behaviour. New values are placed wherever the
+ *  search for them ends and the tree is never restructured, so values that
+ *  arrive in sorted order will degrade the tree into a linked list.
+ *
+ *  AVLBalanced rotates nodes on the way back up from every insert and remove
+ *  so that the heights of each node's two subtrees never differ by more than
+ *  one. The height of the tree is then bounded by ~1.44 log2(n), guaranteeing
+ *  O(log n) insert, remove and contains whatever order the values arrive in.
+ *
+ *  Splay moves every value it touches to the root with a series of
+ *  rotations (splaying), roughly halving the depth of the path to it as it
+ *  goes. Values that are looked up often therefore stay near the root, and
+ *  a run of lookups costs O(log n) each amortised, or less when a few values
+ *  take most of the lookups. Only lookups through a non-const tree splay;
+ *  const lookups leave the tree as it is, so concurrent readers stay safe.
+ */
+struct Unbalanced {};
+struct AVLBalanced {};
+struct Splay {};
+
+/* Augmentation policies for BinarySearchTree.
+ *
+ *  NoAugmentation keeps Nodes as they are.
+ *
+ *  SubtreeSizes has every Node keep a count of the Nodes in its subtree,
+ *  updated on the way back up from every insert and remove. The tree can then
+ *  find the k-th smallest value (select), count the values below a key (rank)
+ *  and count the values in a range in O(height) without walking them.
+ */
+struct NoAugmentation {};
+struct SubtreeSizes {};
 
 /* Binary Search Tree template class.
  *  
  *  Initialise with an object to create the first node of the tree.
  *  Use the included member functions to add to, remove from and search the 
  *  tree.
- *  Objects must be of a type that is comparable (Can use the comparison 
- *  operators <, >, ==, != etc...) or you will recieve a compiler error.
+ *  Values are ordered with Compare, which defaults to std::less<T>, so
+ *  objects must either support the < operator or come with a comparator.
+ *  A transparent comparator such as std::less<> also lets contains, find and
+ *  the bounds be called with any type it can compare against T, without
+ *  constructing a T (e.g. std::string_view keys for std::string values).
+ *  The optional third template argument selects the balancing policy.
+ *  sjd::AVLTree<T> is provided as shorthand for the balanced tree and has
+ *  the same interface, as does sjd::SplayTree<T> for skewed lookups. The
+ *  optional fourth argument adds order statistics;
+ *  sjd::OrderStatisticTree<T> is an AVLTree that keeps subtree sizes.
  *  Example:
+ *      sjd::BinarySearchTree<int> myTree {};   // myTree: []
+ *      myTree.insert(2);                       // myTree: [2]
+ *      myTree.insert(1);                       // myTree: [2 1]
+ *      myTree.contains(1);                     // true
+ *
+ *      sjd::AVLTree<int> myAVLTree {};
+ *      myAVLTree.insert(1);                    // myAVLTree: [1]
+ *      myAVLTree.insert(2);                    // myAVLTree: [1 2]
+ *      myAVLTree.insert(3);                    // myAVLTree: [2 1 3]
+ *
+ *      sjd::BinarySearchTree<std::string, std::less<>> myStringTree {};
+ *      myStringTree.emplace(3, 'a');           // myStringTree: [aaa]
+ *      myStringTree.contains("aaa"sv);         // true, no std::string made
+ *
+ *      sjd::OrderStatisticTree<int> myStatsTree {};
+ *      for (int value : {10, 20, 30}) {myStatsTree.insert(value);}
+ *      *myStatsTree.select(1);                 // 20
+ *      myStatsTree.rank(25);                   // 2
+ *      myStatsTree.countRange(15, 35);         // 2
  *
  */
-namespace sjd {
-template <typename T>
+template <typename K, typename V, typename Compare, typename Balance>
+class BinarySearchMap;
+
+template <typename T, typename Compare = std::less<T>, typename Balance = Unbalanced,
+          typename Augmentation = NoAugmentation>
 class BinarySearchTree {
+    // maps build their entries in place through __tryEmplace
+    template <typename, typename, typename, typename> friend class BinarySearchMap;
+
+    // true when Compare can compare T against other types (std::less<> etc.)
+    static constexpr bool s_transparent {requires { typename Compare::is_transparent; }};
+    static constexpr bool s_balanced {std::is_same_v<Balance, AVLBalanced>};
+    static constexpr bool s_splay {std::is_same_v<Balance, Splay>};
+    static constexpr bool s_sized {std::is_same_v<Augmentation, SubtreeSizes>};
+
+    // Stands in for a Node field that the tree's policies don't use. It takes
+    // no space and ignores the value the field would start with.
+    template <int>
+    struct NoField {
+        constexpr NoField(int) {}
+    };
+    using Height = std::conditional_t<s_balanced, int, NoField<0>>;
+    using Size = std::conditional_t<s_sized, std::size_t, NoField<1>>;
+
+    // Values can sit behind a Bloom filter if std::hash can hash them and the
+    // tree orders them with std::less, so that the values the tree finds
+    // equal are the ones that hash alike. A comparator of its own could treat
+    // values as equal that hash apart, and the filter would turn them away.
+    static constexpr bool s_hashable {requires (const T& value) {
+        {std::hash<T>{}(value)} -> std::convertible_to<std::size_t>;
+    } && (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>)};
+
 public:
     struct Node {
         T value {};
-        std::shared_ptr<Node> left {nullptr};
-        std::shared_ptr<Node> right {nullptr};
+        [[no_unique_address]] Height height {1};    // only kept by balanced trees
+        [[no_unique_address]] Size size {1};        // Nodes in this subtree. Only
+                                                    // kept with SubtreeSizes.
+        Node* left {nullptr};
+        Node* right {nullptr};
+        Node* parent {nullptr};     // nullptr at the root.
+
+        // value is initialised from make()'s result itself, so it is never
+        // converted or moved, whatever constructors T has.
+        template <typename Make>
+        Node(std::in_place_t, Make&& make) : value(make()) {}
+        explicit Node(const T& source) : value(source) {}
+        // Nodes stay where the arena put them and are never copied.
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
     };
 
     BinarySearchTree()
@@ -42,134 +167,1352 @@ public:
     {
     }
 
-    std::shared_ptr<Node> begin() const { return m_root; }
+    explicit BinarySearchTree(const Compare& compare)
+    : m_root {}
+    , m_size {0}
+    , m_compare {compare}
+    {
+    }
+
+    /* Builds a perfectly balanced tree from a range of values in O(n), or
+     * O(n log n) if the values first need sorting. Duplicates are dropped.
+     */
+    template <std::input_iterator InputIt>
+    BinarySearchTree(InputIt first, InputIt last)
+    : m_root {}
+    , m_size {0}
+    {
+        insertBulk(first, last);
+    }
+
+    ~BinarySearchTree() { __clear(); }
 
-    bool insert(const T& value) {
-        auto newNode {std::make_shared<Node>(value)};
-        if (!m_root) {
-            // empty tree
-            m_root = newNode;
-            ++m_size;
-            return true;
+    // Copy constructor
+    BinarySearchTree(const BinarySearchTree& source)
+    : m_root {}
+    , m_size {0}
+    , m_compare {source.m_compare}
+    {
+        deepCopy(source);
+    }
+
+    void deepCopy(const BinarySearchTree& source) {
+        __clear();
+        m_nodes.reserve(source.m_size);
+        m_root = __clone(source.m_root, nullptr);
+        m_size = source.m_size;
+        if constexpr (s_hashable) {
+            if (source.m_filter) {enableFilter(source.m_filter -> bitsPerValue);}
+            else {disableFilter();}
         }
-        std::shared_ptr<Node> temp {m_root};
-        while (true) {
-            if (newNode -> value == temp -> value) {return false;}  // duplicate
-            if (newNode -> value < temp -> value) { // start at root
-                if (!(temp -> left)) {              // if less than, move left
-                    temp -> left = newNode;
-                    ++m_size;
-                    return true;
+    }
+
+    BinarySearchTree& operator=(const BinarySearchTree& source) {
+        if (this != &source) {
+            deepCopy(source);
+        }
+        return *this;
+    }
+
+    // Move constructor. Takes the source's Nodes, and its filter if it has
+    // one, and leaves it empty.
+    BinarySearchTree(BinarySearchTree&& source) noexcept
+    : m_root {std::exchange(source.m_root, nullptr)}
+    , m_size {std::exchange(source.m_size, 0)}
+    , m_nodes {std::move(source.m_nodes)}
+    , m_compare {source.m_compare}
+    , m_filter {std::move(source.m_filter)}
+    {
+    }
+
+    BinarySearchTree& operator=(BinarySearchTree&& source) noexcept {
+        if (this != &source) {
+            __clear();
+            m_filter.reset();
+            swap(source);
+        }
+        return *this;
+    }
+
+    void swap(BinarySearchTree& other) noexcept {
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+        m_nodes.swap(other.m_nodes);
+        std::swap(m_compare, other.m_compare);
+        std::swap(m_filter, other.m_filter);
+    }
+
+    friend void swap(BinarySearchTree& a, BinarySearchTree& b) noexcept { a.swap(b); }
+
+    /* Bidirectional iterator over the values in sorted order.
+     * Steps use the parent pointers, so a walk over k values costs O(k)
+     * amortised after the O(log n) search for the first one and never
+     * allocates. Values can't be changed through an iterator as that could
+     * break the ordering of the tree, so iterator and const_iterator are the
+     * same type.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_node -> value; }
+        pointer operator->() const { return &(m_node -> value); }
+
+        // in-order successor: leftmost of the right subtree, else the first
+        // ancestor reached from its left
+        const_iterator& operator++() {
+            if (m_node -> right) {
+                m_node = __leftmost(m_node -> right);
+            }
+            else {
+                const Node* child {m_node};
+                m_node = m_node -> parent;
+                while (m_node && child == m_node -> right) {
+                    child = m_node;
+                    m_node = m_node -> parent;
                 }
-                temp = temp -> left;
+            }
+            return *this;
+        }
+
+        // in-order predecessor. Stepping back from end() lands on the maximum.
+        const_iterator& operator--() {
+            if (!m_node) {
+                m_node = __rightmost(m_tree -> m_root);
+            }
+            else if (m_node -> left) {
+                m_node = __rightmost(m_node -> left);
             }
             else {
-                if (!(temp -> right)) {             // if more than, move right
-                    temp -> right = newNode;
-                    ++m_size;
-                    return true;
+                const Node* child {m_node};
+                m_node = m_node -> parent;
+                while (m_node && child == m_node -> left) {
+                    child = m_node;
+                    m_node = m_node -> parent;
                 }
-                temp = temp -> right;
             }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old {*this};
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return m_node == other.m_node; }
+
+        const Node* node() const { return m_node; }
+
+    private:
+        friend class BinarySearchTree;
+        template <typename, typename, typename, typename> friend class BinarySearchMap;
+
+        const_iterator(const Node* node, const BinarySearchTree* tree)
+        : m_node {node}
+        , m_tree {tree}
+        {
         }
+
+        const Node* m_node {nullptr};                   // nullptr at end()
+        const BinarySearchTree* m_tree {nullptr};       // lets end() step back
+    };
+    using iterator = const_iterator;
+    using reverse_iterator = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    Node* root() const { return m_root; }
+    std::size_t size() const { return m_size; }
+
+    const_iterator begin() const { return {__leftmost(m_root), this}; }
+    const_iterator end() const { return {nullptr, this}; }
+    reverse_iterator rbegin() const { return reverse_iterator{end()}; }
+    reverse_iterator rend() const { return reverse_iterator{begin()}; }
+
+    bool insert(const T& value) { return __insert(value); }
+
+    // The value is moved into its Node rather than copied.
+    bool insert(T&& value) { return __insert(std::move(value)); }
+
+    // Constructs the value from the arguments then moves it into its Node.
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        return __insert(T(std::forward<Args>(args)...));
     }
 
-    bool contains(const T& value) const {
-        std::shared_ptr<Node> temp {m_root};
-        while (temp) {
-            if (value < temp -> value) {temp = temp -> left;}
-            else if (value > temp -> value) {temp = temp -> right;}
-            else {return true;}
-            return false;
+    /* Adds every value in the range and rebuilds the tree perfectly balanced.
+     * The values are sorted only if they aren't already, merged with the
+     * tree's own in-order values and laid out bottom-up into Nodes taken from
+     * one contiguous run of the arena. Large trees are built on several
+     * threads. Returns the number of values that were new to the tree.
+     * O(n + m), plus O(m log m) if the range is unsorted.
+     */
+    template <std::input_iterator InputIt>
+    std::size_t insertBulk(InputIt first, InputIt last) {
+        std::vector<T> values(first, last);
+        if (!std::is_sorted(values.begin(), values.end(), m_compare)) {
+            std::sort(values.begin(), values.end(), m_compare);
+        }
+        // sorted, so neighbours are equal unless the first is less
+        values.erase(std::unique(values.begin(), values.end(), [this](const T& a, const T& b) {
+            return !m_compare(a, b);
+        }), values.end());
+        std::size_t oldSize {m_size};
+        if (m_root) {
+            std::vector<T> existing {dfsInOrder()};
+            std::vector<T> merged {};
+            merged.reserve(existing.size() + values.size());
+            std::set_union(existing.begin(), existing.end(), values.begin(), values.end(),
+                           std::back_inserter(merged), m_compare);
+            values = std::move(merged);
+        }
+        __clear();
+        if (!values.empty()) {
+            Node* run {m_nodes.allocateRun(values.size())};
+            m_root = __r_buildBalanced(values, run, 0, values.size(), nullptr, __parallelDepth());
+            m_size = values.size();
         }
+        __rebuildFilter();
+        return m_size - oldSize;
     }
 
-    T min(std::shared_ptr<Node> currNode) {
-        while (currNode -> left){
-            currNode = currNode -> left;
+    /* Set operations. Each is built on join, which links two trees and a
+     * middle Node whose value sits between them, and split, which cuts a tree
+     * in two around a key; both take O(log n) on a balanced tree. The tree is
+     * split around each of the other tree's Nodes in turn and the halves
+     * combined, those on either side of the other tree's top few Nodes in
+     * parallel when both trees are large. For AVL trees this costs
+     * O(m log(n/m + 1)) for trees of m <= n values, so folding a small tree
+     * into a large one touches only the paths it needs. Below the parallel
+     * levels nothing recurses, so unbalanced or splay trees of any height
+     * work too, if in up to O(n m).
+     * Nodes that are kept are relinked, never copied. unionWith copies the
+     * other tree's Nodes into this tree's arena up front so the parallel
+     * phase never allocates.
+     *
+     *  unionWith adds every value of other and returns how many were new.
+     *  intersectWith keeps only the values also in other and returns how
+     *  many were removed.
+     *  differenceWith removes every value in other and returns how many
+     *  were removed.
+     */
+    std::size_t unionWith(const BinarySearchTree& other) {
+        if (&other == this || !other.m_root) {return 0;}
+        std::size_t oldSize {m_size};
+        m_nodes.reserve(other.m_size);
+        Node* copy {__clone(other.m_root, nullptr)};
+        std::vector<Node*> duplicates {};
+        m_root = __r_combine<SetOperation::Union>(m_root, copy, duplicates,
+                                                  __parallelDepthFor(other.m_size));
+        __finishCombine(duplicates);
+        m_size += other.m_size;
+        if constexpr (s_hashable) {
+            if (m_filter && m_size <= m_filter -> bloom.capacity()) {
+                for (const T& value : other) {m_filter -> bloom.insert(value);}
+            }
+            else {__rebuildFilter();}
         }
-        return currNode -> value;
+        return m_size - oldSize;
+    }
+
+    std::size_t intersectWith(const BinarySearchTree& other) {
+        if (&other == this) {return 0;}
+        std::vector<Node*> removed {};
+        m_root = __r_combine<SetOperation::Intersection>(m_root, other.m_root, removed,
+                                                         __parallelDepthFor(other.m_size));
+        std::size_t count {__finishCombine(removed)};
+        __filterRemoved(count);
+        return count;
+    }
+
+    std::size_t differenceWith(const BinarySearchTree& other) {
+        if (&other == this) {
+            std::size_t oldSize {m_size};
+            __clear();
+            __rebuildFilter();
+            return oldSize;
+        }
+        std::vector<Node*> removed {};
+        m_root = __r_combine<SetOperation::Difference>(m_root, other.m_root, removed,
+                                                       __parallelDepthFor(other.m_size));
+        std::size_t count {__finishCombine(removed)};
+        __filterRemoved(count);
+        return count;
+    }
+
+    /* Moves every value that is not less than key into the returned tree.
+     * The cut itself takes O(height), O(log n) on a balanced tree, without
+     * recursing, but each tree owns
+     * its own arena so the moved values are copied across: O(log n + k) for
+     * k moved values.
+     */
+    BinarySearchTree split(const T& key) {
+        BinarySearchTree upper {m_compare};
+        Path path {};
+        Split parts {__split(m_root, key, path)};
+        m_root = parts.left;
+        if (m_root) {m_root -> parent = nullptr;}
+        Node* upperRoot {parts.match ? __join(nullptr, parts.match, parts.right) : parts.right};
+        if (!upperRoot) {return upper;}
+        upperRoot -> parent = nullptr;
+
+        std::vector<Node*> moved {};
+        __collect(upperRoot, moved);
+        upper.m_nodes.reserve(moved.size());
+        upper.m_root = upper.__clone(upperRoot, nullptr);
+        upper.m_size = moved.size();
+        for (Node* node : moved) {m_nodes.destroy(node);}
+        m_size -= moved.size();
+        __filterRemoved(moved.size());
+        return upper;
     }
 
-    std::shared_ptr<Node> __r_removeNode(std::shared_ptr<Node> currNode, T value){
-        if (!currNode) {return nullptr;}
-        else if (value < currNode -> value) {
-            currNode -> left = __r_removeNode(currNode -> left, value);
+    bool contains(const T& value) const {
+        if constexpr (s_hashable) {
+            if (m_filter) {return __filteredContains(value);}
         }
-        else if (value > currNode -> value) {
-            currNode -> right = __r_removeNode(currNode -> right, value);
+        return __contains(value);
+    }
+
+    template <typename K> requires s_transparent
+    bool contains(const K& key) const { return __contains(key); }
+
+    // Splay trees splay the last Node the search reaches, found or not.
+    bool contains(const T& value) requires s_splay {
+        if constexpr (s_hashable) {
+            if (m_filter && !__filterAdmits(value)) {return false;}
         }
-        else {
-            if (!(currNode -> left) && !(currNode -> right)) {return nullptr;}
-            else if (!(currNode -> right)) {return currNode -> left;}
-            else if (!(currNode -> left)) {return currNode -> right;}
-            else {
-                currNode -> value = min(currNode -> right);
-                currNode -> right = __r_removeNode(currNode -> right, currNode -> value);
+        bool found {__splayTo(value)};
+        if constexpr (s_hashable) {
+            if (m_filter && !found) {m_filter -> falsePositives.fetch_add(1, std::memory_order_relaxed);}
+        }
+        return found;
+    }
+
+    template <typename K> requires (s_splay && s_transparent)
+    bool contains(const K& key) { return __splayTo(key); }
+
+    const_iterator find(const T& value) const { return __find(value); }
+
+    /* An optional Bloom filter in front of contains(). A value the filter
+     * has never seen is turned away after reading one cache line, without
+     * walking the tree; only values that pass are searched for. It suits
+     * trees where most lookups miss. The filter follows every insert, and
+     * is rebuilt once the tree has outgrown it or after enough removes, as a
+     * Bloom filter can't forget a value. Transparent lookups by other key
+     * types bypass it. Only available for values std::hash can hash in
+     * trees ordered by std::less, as the filter must agree with Compare on
+     * which values are equal.
+     *
+     *  enableFilter builds the filter from the current values, spending
+     *  about bitsPerValue bits on each; 10 gives roughly 1% false positives.
+     *  filterStats reports what the filter costs and how well it is doing
+     *  since it was enabled.
+     */
+    void enableFilter(double bitsPerValue = 10.0) requires s_hashable {
+        m_filter = std::make_unique<Filter>(std::max(m_size, s_minFilterCapacity), bitsPerValue);
+        for (const T& value : *this) {m_filter -> bloom.insert(value);}
+    }
+
+    void disableFilter() { m_filter.reset(); }
+
+    struct FilterStats {
+        std::size_t bytes {0};                  // memory held by the filter
+        double bitsPerValue {0.0};              // bytes spread over the tree's values
+        std::size_t queries {0};                // contains() calls it answered first
+        std::size_t rejected {0};               // turned away without a search
+        std::size_t falsePositives {0};         // passed, then not found in the tree
+        double observedFalsePositiveRate {0.0}; // falsePositives of all the misses
+        double estimatedFalsePositiveRate {0.0};// expected from how full it is
+    };
+
+    FilterStats filterStats() const requires s_hashable {
+        FilterStats stats {};
+        if (!m_filter) {return stats;}
+        stats.bytes = m_filter -> bloom.bytes();
+        stats.bitsPerValue = m_size ? 8.0 * static_cast<double>(stats.bytes) / static_cast<double>(m_size) : 0.0;
+        stats.queries = m_filter -> queries.load(std::memory_order_relaxed);
+        stats.rejected = m_filter -> rejected.load(std::memory_order_relaxed);
+        stats.falsePositives = m_filter -> falsePositives.load(std::memory_order_relaxed);
+        std::size_t misses {stats.rejected + stats.falsePositives};
+        stats.observedFalsePositiveRate = misses ? static_cast<double>(stats.falsePositives) / static_cast<double>(misses) : 0.0;
+        stats.estimatedFalsePositiveRate = m_filter -> bloom.estimatedFalsePositiveRate();
+        return stats;
+    }
+
+    template <typename K> requires s_transparent
+    const_iterator find(const K& key) const { return __find(key); }
+
+    // First value that is not less than the given value. O(log n) when balanced.
+    const_iterator lower_bound(const T& value) const { return {__lowerBound(value), this}; }
+
+    template <typename K> requires s_transparent
+    const_iterator lower_bound(const K& key) const { return {__lowerBound(key), this}; }
+
+    // First value that is greater than the given value. O(log n) when balanced.
+    const_iterator upper_bound(const T& value) const { return {__upperBound(value), this}; }
+
+    template <typename K> requires s_transparent
+    const_iterator upper_bound(const K& key) const { return {__upperBound(key), this}; }
+
+    std::pair<const_iterator, const_iterator> equal_range(const T& value) const {
+        return {lower_bound(value), upper_bound(value)};
+    }
+
+    template <typename K> requires s_transparent
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /* A view of the values in [low, high) that can be used in a range-for or
+     * passed to the standard algorithms. Nothing is copied; walking k values
+     * costs O(log n + k).
+     *  Example:
+     *      for (int value : myTree.range(10, 20)) {...}
+     */
+    std::ranges::subrange<const_iterator> range(const T& low, const T& high) const {
+        if (!m_compare(low, high)) {return {end(), end()};}
+        return {lower_bound(low), lower_bound(high)};
+    }
+
+    /* Order statistics. Only available with SubtreeSizes; each is a single
+     * descent of the tree.
+     *
+     *  select(k) is the k-th smallest value counting from 0, or end() if
+     *  there are fewer than k + 1 values.
+     *  rank(value) is the number of values less than the given value, which
+     *  is also the index select() would find it at.
+     *  countRange(low, high) is the number of values in [low, high).
+     */
+    const_iterator select(std::size_t k) const requires s_sized {
+        const Node* temp {m_root};
+        while (temp) {
+            std::size_t leftSize {__size(temp -> left)};
+            if (k < leftSize) {temp = temp -> left;}
+            else if (k > leftSize) {
+                k -= leftSize + 1;
+                temp = temp -> right;
             }
+            else {return {temp, this};}
         }
-        return currNode;
+        return end();
+    }
+
+    std::size_t rank(const T& value) const requires s_sized { return __rank(value); }
+
+    template <typename K> requires (s_sized && s_transparent)
+    std::size_t rank(const K& key) const { return __rank(key); }
+
+    std::size_t countRange(const T& low, const T& high) const requires s_sized {
+        if (!m_compare(low, high)) {return 0;}
+        return __rank(high) - __rank(low);
+    }
+
+    template <typename K> requires (s_sized && s_transparent)
+    std::size_t countRange(const K& low, const K& high) const {
+        if (!m_compare(low, high)) {return 0;}
+        return __rank(high) - __rank(low);
     }
 
-    void remove(T value){
-        m_root = __r_removeNode(m_root, value);
+    T min(Node* currNode) {
+        while (currNode -> left){
+            currNode = currNode -> left;
+        }
+        return currNode -> value;
     }
 
-    /* Performs a breadth-first search using a queue to keep track of the order
-     * of the Nodes.
+    /* Finds the value with one descent, then unlinks its Node and rebalances
+     * back up the parent pointers, so removal needs no recursion or stack
+     * however deep the tree is. A Node with two children is replaced by its
+     * successor's Node, relinked into its place, so no other value moves and
+     * only iterators to the removed value are invalidated.
+     * Returns false if the value wasn't in the tree.
      */
-    std::vector<std::shared_ptr<Node>> elementsTopDown() const {
-        std::vector<std::shared_ptr<Node>> results {};
-        if (m_size == 0) {return results;}
-        std::shared_ptr<Node> currNode {nullptr};
-        sjd::Queue<std::shared_ptr<Node>> queue {};
-        queue.enqueue(m_root);
+    bool remove(const T& value) { return __remove(value); }
+
+    template <typename K> requires s_transparent
+    bool remove(const K& key) { return __remove(key); }
 
-        while (queue.length() > 0) {
-            currNode = (queue.dequeue() -> value);
-            results.push_back(currNode);
+    /* Calls visit on every Node in breadth-first order. The queue of Nodes
+     * waiting to be visited is a ring buffer that holds at most one level of
+     * the tree; pass one in to reuse its memory from walk to walk.
+     */
+    template <typename Visit>
+    void visitTopDown(Visit visit, RingBuffer<const Node*>& queue) const {
+        queue.clear();
+        if (m_root) {queue.enqueue(m_root);}
+        while (!queue.empty()) {
+            const Node* currNode {queue.dequeue()};
+            visit(currNode);
             if (currNode -> left) {queue.enqueue(currNode -> left);}
             if (currNode -> right) {queue.enqueue(currNode -> right);}
         }
+    }
 
-        return results;
+    template <typename Visit>
+    void visitTopDown(Visit visit) const {
+        RingBuffer<const Node*> queue {};
+        visitTopDown(visit, queue);
     }
 
-    // Recursively steps through the bst
-    void __r_traverseDfsInOrder(std::shared_ptr<Node> currNode, std::vector<T>& arrayOut) const {
-        if (currNode -> left) {__r_traverseDfsInOrder(currNode -> left, arrayOut);}
-        arrayOut.push_back(currNode -> value);
-        if (currNode -> right) {__r_traverseDfsInOrder(currNode -> right, arrayOut);}
+    // Every Node in breadth-first order.
+    std::vector<const Node*> elementsTopDown() const {
+        std::vector<const Node*> results {};
+        results.reserve(m_size);
+        visitTopDown([&results](const Node* node) { results.push_back(node); });
+        return results;
     }
 
+    // Steps through the tree with its iterators, so nothing is recursive.
     std::vector<T> dfsInOrder() const {
         std::vector<T> results{};
-        __r_traverseDfsInOrder(m_root, results);
+        results.reserve(m_size);
+        for (const T& value : *this) {results.push_back(value);}
         return results;
     }
 
+    /* Parallel visits. The tree is cut at the Nodes of its top few levels and
+     * the subtrees below them are handed to a sjd::WorkStealingPool (the
+     * shared one unless another is passed); there are several subtrees per
+     * worker so that stealing can even out subtrees of different sizes.
+     * Each subtree is walked with the iterators, so nothing is allocated per
+     * Node. The tree must not be changed until the call returns.
+     *
+     *  parallelForEach calls fn(value) once for every value, concurrently
+     *  and in no particular order.
+     *  parallelReduce folds each run of values into a copy of init with
+     *  fold(result, value), then combines neighbouring results with
+     *  combine(left, right). Runs are combined in sorted order, so combine
+     *  must be associative but needn't be commutative, and init must be its
+     *  identity (0 for +, "" for string concatenation). With one op it is
+     *  used as both fold and combine.
+     */
+    template <typename Fn>
+    void parallelForEach(Fn fn, WorkStealingPool& pool = WorkStealingPool::shared()) const {
+        WorkStealingPool::TaskGroup group {pool};
+        __r_parallelForEach(m_root, fn, __splitDepth(pool), group);
+        group.wait();
+    }
+
+    template <typename R, typename Fold, typename Combine>
+    R parallelReduce(R init, Fold fold, Combine combine,
+                     WorkStealingPool& pool = WorkStealingPool::shared()) const {
+        return __r_parallelReduce(m_root, init, fold, combine, __splitDepth(pool), pool);
+    }
+
+    template <typename R, typename Op>
+    R parallelReduce(R init, Op op, WorkStealingPool& pool = WorkStealingPool::shared()) const {
+        return parallelReduce(std::move(init), op, op, pool);
+    }
+
+    /* Takes a read-only snapshot of the tree's values laid out in Eytzinger
+     * order. The snapshot is unaffected by later changes to the tree.
+     */
+    FrozenSet<T, Compare> freeze() const {
+        return FrozenSet<T, Compare>{dfsInOrder(), m_compare};
+    }
+
+    /* Saves a frozen snapshot of the tree to a file that loadMapped() can map
+     * straight back into memory, e.g. to skip rebuilding the tree on startup.
+     * Returns false if the file couldn't be written.
+     */
+    bool save(const std::string& path) const requires std::is_trivially_copyable_v<T> {
+        return freeze().save(path);
+    }
+
+    static std::optional<FrozenSet<T, Compare>> loadMapped(const std::string& path,
+                                                           const Compare& compare = Compare{})
+        requires std::is_trivially_copyable_v<T> {
+        return FrozenSet<T, Compare>::loadMapped(path, compare);
+    }
+
 
-    friend std::ostream& operator<< (std::ostream& out, const BinarySearchTree<T>& bst) {
+    friend std::ostream& operator<< (std::ostream& out, const BinarySearchTree& bst) {
         out << "BST[ ";
-        std::vector elements {bst.elementsTopDown()};
-        for (std::shared_ptr<Node> node : elements){
-            out << node -> value << " ";
-        }
+        bst.visitTopDown([&out](const Node* node) { out << node -> value << " "; });
         out << "]";
         return out;
     }
 
 private:
-    std::shared_ptr<Node> m_root {nullptr};
+    Node* m_root {nullptr};
     std::size_t m_size {};
-    
-    void __r_traverseDfsInOrder(std::shared_ptr<Node> currNode, std::vector<std::shared_ptr<Node>>& arrayOut) {
-        if (currNode -> left) {__r_traverseDfsInOrder(currNode -> left);}
-        arrayOut.push_back(currNode);
-        if (currNode -> right) {__r_traverseDfsInOrder(currNode -> right);}
+    NodeArena<Node> m_nodes {};     // owns every Node reachable from m_root
+    [[no_unique_address]] Compare m_compare {};
+
+    // The counters are atomic so concurrent readers can keep calling
+    // contains(); they are only ever read for stats.
+    struct Filter {
+        Filter(std::size_t capacity, double bits)
+        : bloom {capacity, bits}
+        , bitsPerValue {bits}
+        {
+        }
+
+        BlockedBloomFilter<T> bloom;
+        double bitsPerValue {};
+        std::size_t removed {0};        // values removed since it was built
+        mutable std::atomic<std::size_t> queries {0};
+        mutable std::atomic<std::size_t> rejected {0};
+        mutable std::atomic<std::size_t> falsePositives {0};
+    };
+    std::unique_ptr<Filter> m_filter {};    // nullptr unless enabled
+
+    static constexpr std::size_t s_minFilterCapacity {1024};
+
+    bool __filterAdmits(const T& value) const {
+        m_filter -> queries.fetch_add(1, std::memory_order_relaxed);
+        if (m_filter -> bloom.mayContain(value)) {return true;}
+        m_filter -> rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool __filteredContains(const T& value) const {
+        if (!__filterAdmits(value)) {return false;}
+        bool found {__contains(value)};
+        if (!found) {m_filter -> falsePositives.fetch_add(1, std::memory_order_relaxed);}
+        return found;
+    }
+
+    // Rebuilt with room for the tree to double, keeping the stats.
+    void __rebuildFilter() {
+        if constexpr (s_hashable) {
+            if (!m_filter) {return;}
+            auto filter {std::make_unique<Filter>(std::max(2 * m_size, s_minFilterCapacity), m_filter -> bitsPerValue)};
+            filter -> queries.store(m_filter -> queries.load());
+            filter -> rejected.store(m_filter -> rejected.load());
+            filter -> falsePositives.store(m_filter -> falsePositives.load());
+            for (const T& value : *this) {filter -> bloom.insert(value);}
+            m_filter = std::move(filter);
+        }
+    }
+
+    void __filterAdded([[maybe_unused]] const T& value) {
+        if constexpr (s_hashable) {
+            if (!m_filter) {return;}
+            if (m_size > m_filter -> bloom.capacity()) {__rebuildFilter();}
+            else {m_filter -> bloom.insert(value);}
+        }
+    }
+
+    // Removed values still pass the filter until it is rebuilt, which is
+    // left until they are as many as half of the values still in the tree.
+    void __filterRemoved([[maybe_unused]] std::size_t count) {
+        if constexpr (s_hashable) {
+            if (!m_filter) {return;}
+            m_filter -> removed += count;
+            if (2 * m_filter -> removed > std::max(m_size, s_minFilterCapacity)) {__rebuildFilter();}
+        }
+    }
+
+    /* Searches take a single comparison per level. Rather than stopping when
+     * a Node compares equal, which needs a second comparison to tell equal
+     * from greater, the descent always runs to the bottom remembering the
+     * last Node that wasn't less than the key. That Node is the lower bound
+     * and the key is in the tree only if it isn't less than the bound either.
+     */
+    template <typename K>
+    const Node* __lowerBound(const K& key) const {
+        const Node* bound {nullptr};
+        const Node* temp {m_root};
+        while (temp) {
+            if (m_compare(temp -> value, key)) {temp = temp -> right;}
+            else {
+                bound = temp;
+                temp = temp -> left;
+            }
+        }
+        return bound;
+    }
+
+    template <typename K>
+    const Node* __upperBound(const K& key) const {
+        const Node* bound {nullptr};
+        const Node* temp {m_root};
+        while (temp) {
+            if (m_compare(key, temp -> value)) {
+                bound = temp;
+                temp = temp -> left;
+            }
+            else {temp = temp -> right;}
+        }
+        return bound;
+    }
+
+    // Counts the Nodes passed on the left during a lower bound descent.
+    template <typename K>
+    std::size_t __rank(const K& key) const {
+        std::size_t count {0};
+        const Node* temp {m_root};
+        while (temp) {
+            if (m_compare(temp -> value, key)) {
+                count += __size(temp -> left) + 1;
+                temp = temp -> right;
+            }
+            else {temp = temp -> left;}
+        }
+        return count;
+    }
+
+    template <typename K>
+    const_iterator __find(const K& key) const {
+        const Node* bound {__lowerBound(key)};
+        if (bound && !m_compare(key, bound -> value)) {return {bound, this};}
+        return end();
+    }
+
+    template <typename K>
+    bool __contains(const K& key) const {
+        const Node* bound {__lowerBound(key)};
+        return bound && !m_compare(key, bound -> value);
+    }
+
+    template <typename K>
+    bool __remove(const K& key) {
+        Node* node {m_root};
+        while (node) {
+            if (m_compare(key, node -> value)) {node = node -> left;}
+            else if (m_compare(node -> value, key)) {node = node -> right;}
+            else {break;}
+        }
+        if (!node) {return false;}
+        Node* parent {node -> parent};      // the lowest Node that changed
+        if (node -> left && node -> right) {
+            Node* successor {node -> right};
+            while (successor -> left) {successor = successor -> left;}
+            if (successor == node -> right) {parent = successor;}
+            else {
+                parent = successor -> parent;
+                parent -> left = successor -> right;
+                if (successor -> right) {successor -> right -> parent = parent;}
+                successor -> right = node -> right;
+                successor -> right -> parent = successor;
+            }
+            successor -> left = node -> left;
+            successor -> left -> parent = successor;
+            successor -> parent = node -> parent;
+            __owner(node) = successor;
+        }
+        else {
+            Node* child {node -> left ? node -> left : node -> right};
+            if (child) {child -> parent = parent;}
+            __owner(node) = child;
+        }
+        m_nodes.destroy(node);
+        --m_size;
+        __rebalanceUpFrom(parent);
+        if constexpr (s_splay) {
+            if (parent) {__splay(parent);}
+        }
+        __filterRemoved(1);
+        return true;
+    }
+
+    template <typename V>
+    bool __insert(V&& value) {
+        return __tryEmplace(value, [&value]() -> T { return std::forward<V>(value); }).second;
+    }
+
+    /* Same single comparison descent as __lowerBound, also remembering which
+     * child pointer a value for key would hang from. make is only called,
+     * and the new value only built, if key isn't in the tree already.
+     * Returns the Node for key and whether it was created.
+     */
+    template <typename K, typename Make>
+    std::pair<Node*, bool> __tryEmplace(const K& key, Make make) {
+        Node* parent {nullptr};
+        Node** slot {&m_root};
+        Node* bound {nullptr};
+        while (*slot) {
+            parent = *slot;
+            if (m_compare(parent -> value, key)) {slot = &(parent -> right);}
+            else {
+                bound = parent;
+                slot = &(parent -> left);
+            }
+        }
+        if (bound && !m_compare(key, bound -> value)) {       // duplicate
+            if constexpr (s_splay) {__splay(bound);}
+            return {bound, false};
+        }
+        Node* node {m_nodes.create(std::in_place, make)};
+        *slot = node;
+        node -> parent = parent;
+        ++m_size;
+        __rebalanceUpFrom(parent);
+        if constexpr (s_splay) {__splay(node);}
+        __filterAdded(node -> value);
+        return {node, true};
+    }
+
+    // Cuts the tree into about eight subtrees per worker.
+    static int __splitDepth(const WorkStealingPool& pool) {
+        return static_cast<int>(std::bit_width(pool.size())) + 2;
+    }
+
+    // Visits a whole subtree in order with the iterators.
+    template <typename Visit>
+    void __visitSubtree(const Node* node, Visit& visit) const {
+        const_iterator it {__leftmost(node), this};
+        const Node* last {__rightmost(node)};
+        while (true) {
+            visit(*it);
+            if (it.node() == last) {return;}
+            ++it;
+        }
+    }
+
+    template <typename Fn>
+    void __r_parallelForEach(const Node* node, Fn& fn, int depth, WorkStealingPool::TaskGroup& group) const {
+        if (!node) {return;}
+        if (depth <= 0) {
+            __visitSubtree(node, fn);
+            return;
+        }
+        group.run([this, node, &fn, depth, &group] {
+            __r_parallelForEach(node -> left, fn, depth - 1, group);
+        });
+        fn(node -> value);
+        __r_parallelForEach(node -> right, fn, depth - 1, group);
+    }
+
+    template <typename R, typename Fold, typename Combine>
+    R __r_parallelReduce(const Node* node, const R& init, Fold& fold, Combine& combine,
+                         int depth, WorkStealingPool& pool) const {
+        if (!node) {return init;}
+        if (depth <= 0) {
+            R result {init};
+            auto visit {[&result, &fold](const T& value) { result = fold(std::move(result), value); }};
+            __visitSubtree(node, visit);
+            return result;
+        }
+        R left {init};
+        WorkStealingPool::TaskGroup group {pool};
+        group.run([&] {
+            left = __r_parallelReduce(node -> left, init, fold, combine, depth - 1, pool);
+        });
+        R right {__r_parallelReduce(node -> right, init, fold, combine, depth - 1, pool)};
+        R middle {fold(R{init}, node -> value)};
+        group.wait();
+        return combine(combine(std::move(left), std::move(middle)), std::move(right));
+    }
+
+    // Subtrees smaller than this are never worth handing to another thread.
+    static constexpr std::size_t s_parallelBuildGrain {std::size_t{1} << 15};
+
+    // How many times work can be forked in two to keep every core busy.
+    static int __parallelDepth() {
+        unsigned threads {std::max(std::thread::hardware_concurrency(), 1u)};
+        return static_cast<int>(std::bit_width(threads)) - 1;
+    }
+
+    // Set operations only fork when both trees are worth splitting up.
+    int __parallelDepthFor(std::size_t otherSize) const {
+        return std::min(m_size, otherSize) > s_parallelBuildGrain ? __parallelDepth() : 0;
+    }
+
+    /* Lays the sorted values [low, high) out as a perfectly balanced subtree
+     * whose Nodes are constructed in the matching slots of run. The left half
+     * is built on a new thread while parallelDepth lasts.
+     */
+    static Node* __r_buildBalanced(const std::vector<T>& values, Node* run, std::size_t low,
+                                   std::size_t high, Node* parent, int parallelDepth) {
+        if (low >= high) {return nullptr;}
+        std::size_t mid {low + (high - low) / 2};
+        Node* node {std::construct_at(run + mid, values[mid])};
+        node -> parent = parent;
+        if (parallelDepth > 0 && high - low > s_parallelBuildGrain) {
+            auto left {std::async(std::launch::async, [&] {
+                return __r_buildBalanced(values, run, low, mid, node, parallelDepth - 1);
+            })};
+            node -> right = __r_buildBalanced(values, run, mid + 1, high, node, parallelDepth - 1);
+            node -> left = left.get();
+        }
+        else {
+            node -> left = __r_buildBalanced(values, run, low, mid, node, 0);
+            node -> right = __r_buildBalanced(values, run, mid + 1, high, node, 0);
+        }
+        __updateNode(node);
+        return node;
+    }
+
+    Node* __cloneNode(const Node* sourceNode, Node* parent) {
+        Node* node {m_nodes.create(sourceNode -> value)};
+        node -> parent = parent;
+        node -> height = sourceNode -> height;
+        node -> size = sourceNode -> size;
+        return node;
+    }
+
+    /* Copies a subtree in preorder without recursing. The walk climbs back up
+     * the parent pointers of both trees together and a copied Node's missing
+     * child tells it which side still has to be copied.
+     */
+    Node* __clone(const Node* sourceRoot, Node* parent) {
+        if (!sourceRoot) {return nullptr;}
+        Node* root {__cloneNode(sourceRoot, parent)};
+        const Node* from {sourceRoot};
+        Node* to {root};
+        while (to != parent) {
+            if (from -> left && !(to -> left)) {
+                to -> left = __cloneNode(from -> left, to);
+                from = from -> left;
+                to = to -> left;
+            }
+            else if (from -> right && !(to -> right)) {
+                to -> right = __cloneNode(from -> right, to);
+                from = from -> right;
+                to = to -> right;
+            }
+            else {
+                from = from -> parent;
+                to = to -> parent;
+            }
+        }
+        return root;
+    }
+
+    /* Destroys a subtree without recursing or a stack by rotating each left
+     * child up until the Node at the top has none, then dropping it and
+     * moving on to its right child.
+     */
+    void __destroy(Node* node) {
+        while (node) {
+            if (Node* left {node -> left}) {
+                node -> left = left -> right;
+                left -> right = node;
+                node = left;
+            }
+            else {
+                Node* right {node -> right};
+                m_nodes.destroy(node);
+                node = right;
+            }
+        }
+    }
+
+    // Trivially destructible values need no walk; the arena is simply dropped.
+    void __clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            __destroy(m_root);
+        }
+        m_nodes.clear();
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    /* Join and split. Subtrees passed around here are detached: their roots'
+     * parent pointers are stale until they are linked under a Node or made
+     * the root of the tree.
+     */
+    struct Split {
+        Node* left {nullptr};       // values less than the key
+        Node* match {nullptr};      // the Node equal to the key, unlinked
+        Node* right {nullptr};      // values greater than the key
+    };
+
+    // A Node passed on the way down a split, and which child it was left by.
+    struct Step {
+        Node* node {nullptr};
+        bool wentLeft {false};
+    };
+    using Path = std::vector<Step>;
+
+    // An AVL tree of height h holds at least F(h + 2) - 1 values, so no tree
+    // that fits in memory is taller than this.
+    static constexpr std::size_t s_maxHeight {96};
+
+    enum class SetOperation { Union, Intersection, Difference };
+
+    static Node* __link(Node* left, Node* mid, Node* right) {
+        mid -> left = left;
+        mid -> right = right;
+        mid -> parent = nullptr;
+        if (left) {left -> parent = mid;}
+        if (right) {right -> parent = mid;}
+        __updateNode(mid);
+        return mid;
+    }
+
+    // Hangs the shorter tree and mid off the spine of the taller one at the
+    // point where the heights match, rebalancing back up the spine. Only
+    // balanced trees get here, so the spine fits in s_maxHeight.
+    static Node* __joinRight(Node* left, Node* mid, Node* right) {
+        std::array<Node*, s_maxHeight> spine {};
+        std::size_t depth {0};
+        while (__height(left) > __height(right) + 1) {
+            spine[depth++] = left;
+            left = left -> right;
+        }
+        Node* joined {__link(left, mid, right)};
+        while (depth > 0) {
+            Node* above {spine[--depth]};
+            above -> right = joined;
+            joined -> parent = above;
+            joined = __rebalance(above);
+        }
+        return joined;
+    }
+
+    static Node* __joinLeft(Node* left, Node* mid, Node* right) {
+        std::array<Node*, s_maxHeight> spine {};
+        std::size_t depth {0};
+        while (__height(right) > __height(left) + 1) {
+            spine[depth++] = right;
+            right = right -> left;
+        }
+        Node* joined {__link(left, mid, right)};
+        while (depth > 0) {
+            Node* above {spine[--depth]};
+            above -> left = joined;
+            joined -> parent = above;
+            joined = __rebalance(above);
+        }
+        return joined;
+    }
+
+    // Every value in left must be less than mid's and every value in right
+    // greater. Unbalanced trees simply hang the two trees under mid.
+    static Node* __join(Node* left, Node* mid, Node* right) {
+        if constexpr (s_balanced) {
+            if (__height(left) > __height(right) + 1) {return __joinRight(left, mid, right);}
+            if (__height(right) > __height(left) + 1) {return __joinLeft(left, mid, right);}
+        }
+        return __link(left, mid, right);
+    }
+
+    /* Removes the largest Node of a subtree, handing it back through last.
+     * The Nodes on the right spine are joined back together from the bottom
+     * up, path holding them in place of the call stack.
+     */
+    static Node* __splitLast(Node* node, Node*& last, Path& path) {
+        path.clear();
+        while (node -> right) {
+            path.push_back({node, false});
+            node = node -> right;
+        }
+        last = node;
+        Node* rest {node -> left};
+        for (auto step {path.rbegin()}; step != path.rend(); ++step) {
+            rest = __join(step -> node -> left, step -> node, rest);
+        }
+        return rest;
+    }
+
+    // Joins two trees without a middle value by promoting the largest of left.
+    static Node* __join2(Node* left, Node* right, Path& path) {
+        if (!left) {return right;}
+        if (!right) {return left;}
+        Node* last {nullptr};
+        Node* rest {__splitLast(left, last, path)};
+        return __join(rest, last, right);
+    }
+
+    /* Walks down to key, remembering in path which way it went at each Node,
+     * then joins the Nodes passed back onto whichever side they belong to
+     * from the bottom up. path is only scratch space, reused between calls.
+     */
+    Split __split(Node* node, const T& key, Path& path) const {
+        path.clear();
+        Split parts {};
+        while (node) {
+            if (m_compare(key, node -> value)) {
+                path.push_back({node, true});
+                node = node -> left;
+            }
+            else if (m_compare(node -> value, key)) {
+                path.push_back({node, false});
+                node = node -> right;
+            }
+            else {
+                parts = {node -> left, node, node -> right};
+                break;
+            }
+        }
+        for (auto step {path.rbegin()}; step != path.rend(); ++step) {
+            Node* passed {step -> node};
+            if (step -> wentLeft) {parts.right = __join(parts.right, passed, passed -> right);}
+            else {parts.left = __join(passed -> left, passed, parts.left);}
+        }
+        return parts;
+    }
+
+    // Appends every Node of a subtree, level by level, without recursing.
+    static void __collect(Node* node, std::vector<Node*>& nodes) {
+        if (!node) {return;}
+        std::size_t next {nodes.size()};
+        nodes.push_back(node);
+        while (next < nodes.size()) {
+            Node* temp {nodes[next++]};
+            if (temp -> left) {nodes.push_back(temp -> left);}
+            if (temp -> right) {nodes.push_back(temp -> right);}
+        }
+    }
+
+    /* Splits a by the value at b's root and combines the two halves with
+     * b's subtrees, forking the left half off to another thread while
+     * parallelDepth lasts and handing over to __combine after that. Nodes
+     * that are dropped are only collected in garbage, as the arena can't be
+     * used from several threads; each forked half collects into its own
+     * vector. For a union, b is a copy that is consumed.
+     */
+    template <SetOperation op, typename OtherNode>
+    Node* __r_combine(Node* a, OtherNode* b, std::vector<Node*>& garbage, int parallelDepth) const {
+        if (parallelDepth <= 0 || !a || !b) {return __combine<op>(a, b, garbage);}
+        OtherNode* bLeft {b -> left};
+        OtherNode* bRight {b -> right};
+        Path path {};
+        Split parts {__split(a, b -> value, path)};
+        std::vector<Node*> leftGarbage {};
+        auto leftTask {std::async(std::launch::async, [&] {
+            return __r_combine<op>(parts.left, bLeft, leftGarbage, parallelDepth - 1);
+        })};
+        Node* right {__r_combine<op>(parts.right, bRight, garbage, parallelDepth - 1)};
+        Node* left {leftTask.get()};
+        garbage.insert(garbage.end(), leftGarbage.begin(), leftGarbage.end());
+        return __keep<op>(left, b, parts.match, right, garbage, path);
+    }
+
+    /* The same combination on one thread, without recursing: each Node of b
+     * leaves a Frame behind while its left subtree is combined, and picks up
+     * its right subtree once the left result is in.
+     */
+    template <SetOperation op, typename OtherNode>
+    Node* __combine(Node* a, OtherNode* b, std::vector<Node*>& garbage) const {
+        struct Frame {
+            OtherNode* b {nullptr};
+            OtherNode* bRight {nullptr};
+            Node* match {nullptr};
+            Node* aRight {nullptr};
+            Node* left {nullptr};       // the combined left half, once done
+            bool leftDone {false};
+        };
+        std::vector<Frame> frames {};
+        Path path {};
+        while (true) {
+            while (a && b) {
+                Split parts {__split(a, b -> value, path)};
+                frames.push_back({b, b -> right, parts.match, parts.right});
+                a = parts.left;
+                b = b -> left;
+            }
+            Node* result {nullptr};
+            if constexpr (op == SetOperation::Union) {result = a ? a : b;}
+            else if constexpr (op == SetOperation::Intersection) {__collect(a, garbage);}
+            else {result = a;}
+
+            while (!frames.empty() && frames.back().leftDone) {
+                Frame& frame {frames.back()};
+                result = __keep<op>(frame.left, frame.b, frame.match, result, garbage, path);
+                frames.pop_back();
+            }
+            if (frames.empty()) {return result;}
+            Frame& frame {frames.back()};
+            frame.left = result;
+            frame.leftDone = true;
+            a = frame.aRight;
+            b = frame.bRight;
+        }
+    }
+
+    // Joins two combined halves around whichever Node the operation keeps.
+    template <SetOperation op, typename OtherNode>
+    static Node* __keep(Node* left, OtherNode* b, Node* match, Node* right,
+                        std::vector<Node*>& garbage, Path& path) {
+        if constexpr (op == SetOperation::Union) {
+            if (match) {garbage.push_back(match);}
+            return __join(left, b, right);
+        }
+        else if constexpr (op == SetOperation::Intersection) {
+            return match ? __join(left, match, right) : __join2(left, right, path);
+        }
+        else {
+            if (match) {garbage.push_back(match);}
+            return __join2(left, right, path);
+        }
+    }
+
+    // Frees the Nodes a set operation dropped. Returns how many there were.
+    std::size_t __finishCombine(const std::vector<Node*>& garbage) {
+        if (m_root) {m_root -> parent = nullptr;}
+        for (Node* node : garbage) {m_nodes.destroy(node);}
+        m_size -= garbage.size();
+        return garbage.size();
+    }
+
+    static const Node* __leftmost(const Node* node) {
+        if (!node) {return nullptr;}
+        while (node -> left) {node = node -> left;}
+        return node;
+    }
+
+    static const Node* __rightmost(const Node* node) {
+        if (!node) {return nullptr;}
+        while (node -> right) {node = node -> right;}
+        return node;
+    }
+
+    static int __height(const Node* node) {
+        return node ? node -> height : 0;
+    }
+
+    static std::size_t __size(const Node* node) {
+        return node ? node -> size : 0;
+    }
+
+    // Recomputes the height of a balanced tree's Node and, with SubtreeSizes,
+    // its size from its children.
+    static void __updateNode(Node* node) {
+        if constexpr (s_balanced) {
+            node -> height = 1 + std::max(__height(node -> left), __height(node -> right));
+        }
+        if constexpr (s_sized) {
+            node -> size = 1 + __size(node -> left) + __size(node -> right);
+        }
+    }
+
+    static int __balanceFactor(const Node* node) {
+        return __height(node -> left) - __height(node -> right);
+    }
+
+    // Returns the pointer that owns the given Node. Either m_root or one of
+    // its parent's child pointers.
+    Node*& __owner(Node* node) {
+        if (!(node -> parent)) {return m_root;}
+        return (node -> parent -> left == node) ? node -> parent -> left
+                                                      : node -> parent -> right;
+    }
+
+    /* Rotations. Each takes the root of a subtree and returns the new root of
+     * that subtree. The caller is responsible for storing the returned root in
+     * whichever pointer owned the old one; parent pointers are kept correct.
+     *
+     *      x                 y
+     *     / \   rotate     / \
+     *    a   y   left     x   c
+     *       / \  ---->   / \
+     *      b   c        a   b
+     */
+    static Node* __rotateLeft(Node* x) {
+        Node* y {x -> right};
+        x -> right = y -> left;
+        if (x -> right) {x -> right -> parent = x;}
+        y -> parent = x -> parent;
+        x -> parent = y;
+        y -> left = x;
+        __updateNode(x);
+        __updateNode(y);
+        return y;
+    }
+
+    static Node* __rotateRight(Node* y) {
+        Node* x {y -> left};
+        y -> left = x -> right;
+        if (y -> left) {y -> left -> parent = y;}
+        x -> parent = y -> parent;
+        y -> parent = x;
+        x -> right = y;
+        __updateNode(y);
+        __updateNode(x);
+        return x;
+    }
+
+    // Restores the AVL property at a single Node whose subtrees are already
+    // balanced. Unbalanced trees only have the Node's augmentation updated.
+    static Node* __rebalance(Node* node) {
+        if (!node) {return node;}
+        if constexpr (s_balanced || s_sized) {
+            __updateNode(node);
+        }
+        if constexpr (s_balanced) {
+            int balance {__balanceFactor(node)};
+            if (balance > 1) {
+                if (__balanceFactor(node -> left) < 0) {
+                    node -> left = __rotateLeft(node -> left);
+                }
+                return __rotateRight(node);
+            }
+            if (balance < -1) {
+                if (__balanceFactor(node -> right) > 0) {
+                    node -> right = __rotateRight(node -> right);
+                }
+                return __rotateLeft(node);
+            }
+        }
+        return node;
+    }
+
+    // Rotates a Node above its parent.
+    void __rotateUp(Node* node) {
+        Node* parent {node -> parent};
+        Node*& owner {__owner(parent)};
+        owner = (parent -> left == node) ? __rotateRight(parent) : __rotateLeft(parent);
+    }
+
+    /* Rotates a Node all the way up to the root, two levels at a time. When
+     * the Node and its parent are children on the same side the parent is
+     * rotated first (zig-zig), which is what folds long paths in half;
+     * otherwise the Node is rotated twice (zig-zag).
+     */
+    void __splay(Node* node) {
+        while (node -> parent) {
+            Node* parent {node -> parent};
+            Node* grandparent {parent -> parent};
+            if (grandparent) {
+                bool sameSide {(grandparent -> left == parent) == (parent -> left == node)};
+                __rotateUp(sameSide ? parent : node);
+            }
+            __rotateUp(node);
+        }
+    }
+
+    // Searches for key and splays the last Node reached.
+    template <typename K>
+    bool __splayTo(const K& key) {
+        Node* node {m_root};
+        Node* last {nullptr};
+        while (node) {
+            last = node;
+            if (m_compare(key, node -> value)) {node = node -> left;}
+            else if (m_compare(node -> value, key)) {node = node -> right;}
+            else {break;}
+        }
+        if (last) {__splay(last);}
+        return node != nullptr;
+    }
+
+    // Walks from the given Node back up to the root rebalancing as it goes.
+    void __rebalanceUpFrom(Node* node) {
+        if constexpr (s_balanced || s_sized) {
+            while (node) {
+                Node*& owner {__owner(node)};
+                owner = __rebalance(owner);
+                node = owner -> parent;
+            }
+        }
     }
 };
 
+template <typename T, typename Compare = std::less<T>>
+using AVLTree = BinarySearchTree<T, Compare, AVLBalanced>;
+
+template <typename T, typename Compare = std::less<T>>
+using OrderStatisticTree = BinarySearchTree<T, Compare, AVLBalanced, SubtreeSizes>;
+
+template <typename T, typename Compare = std::less<T>>
+using SplayTree = BinarySearchTree<T, Compare, Splay>;
 
 } // end namespace sjd
 #endif
@@ -0,0 +1,270 @@
+#ifndef CONCURRENT_BINARY_SEARCH_TREE_H
+#define CONCURRENT_BINARY_SEARCH_TREE_H
+/* Sam Drew ~ 2025
+ * Concurrent (copy-on-write) Binary Search Tree implementation in C++
+ * ---
+ *  A persistent AVL tree for many concurrent readers and occasional writers.
+ *  Written by me, for my own edification in data structures and algorithms
+ *  and C++.
+ *
+ *  Nodes are immutable once they have been published. A writer never changes
+ *  a Node in place; it copies the O(log n) Nodes on the path from the root to
+ *  the change (plus any Nodes a rebalancing rotation touches), shares every
+ *  other subtree with the old version and then publishes the new root with a
+ *  single atomic store. Readers load the root once and from then on walk a
+ *  consistent version of the tree that no writer will ever modify, without
+ *  taking a lock. Old versions are freed by the shared_ptrs when the last
+ *  reader holding them lets go.
+ *
+ *  Class templating is used to allow the creation of trees of any object
+ *  type. This version doesn't provide deduction guides so will only compile
+ *  with C++20 or newer.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace sjd {
+
+/* Concurrent Binary Search Tree template class.
+ *
+ *  Any number of threads may call the const member functions while one or
+ *  more threads insert and remove; writers are serialised with a mutex.
+ *  Every read sees the tree as it was after some complete write. To make
+ *  several reads against the same version, and to avoid touching the shared
+ *  root's reference count on every call, take a snapshot().
+ *  Example:
+ *      sjd::ConcurrentBinarySearchTree<int> myTree {};
+ *      myTree.insert(2);                       // from any thread
+ *      auto view {myTree.snapshot()};          // view: [2]
+ *      myTree.insert(1);                       // view is still [2]
+ *      view.contains(1);                       // false
+ *      myTree.contains(1);                     // true
+ *
+ *  NOTE: Readers never block, but loading the root goes through
+ *  std::atomic<std::shared_ptr>, which the standard library may implement
+ *  with a short internal lock, so taking a snapshot is not strictly wait-free.
+ *  Walking a snapshot is.
+ */
+template <typename T, typename Compare = std::less<T>>
+class ConcurrentBinarySearchTree {
+public:
+    struct Node {
+        T value {};
+        std::shared_ptr<const Node> left {nullptr};
+        std::shared_ptr<const Node> right {nullptr};
+        int height {1};
+        std::size_t size {1};       // Nodes in this subtree
+    };
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /* An immutable version of the tree. Holding one keeps every Node of that
+     * version alive; walking it needs no synchronisation at all.
+     */
+    class Snapshot {
+    public:
+        Snapshot() = default;
+
+        const Node* root() const { return m_root.get(); }
+        std::size_t size() const { return m_root ? m_root -> size : 0; }
+
+        bool contains(const T& value) const {
+            const Node* temp {m_root.get()};
+            while (temp) {
+                if (m_compare(value, temp -> value)) {temp = temp -> left.get();}
+                else if (m_compare(temp -> value, value)) {temp = temp -> right.get();}
+                else {return true;}
+            }
+            return false;
+        }
+
+        std::vector<T> dfsInOrder() const {
+            std::vector<T> results {};
+            results.reserve(size());
+            __r_traverseDfsInOrder(m_root.get(), results);
+            return results;
+        }
+
+    private:
+        friend class ConcurrentBinarySearchTree;
+
+        Snapshot(NodePtr root, const Compare& compare)
+        : m_root {std::move(root)}
+        , m_compare {compare}
+        {
+        }
+
+        // Recursively steps through the snapshot. Depth is ~1.44 log2(n).
+        static void __r_traverseDfsInOrder(const Node* currNode, std::vector<T>& arrayOut) {
+            if (!currNode) {return;}
+            __r_traverseDfsInOrder(currNode -> left.get(), arrayOut);
+            arrayOut.push_back(currNode -> value);
+            __r_traverseDfsInOrder(currNode -> right.get(), arrayOut);
+        }
+
+        NodePtr m_root {nullptr};
+        [[no_unique_address]] Compare m_compare {};
+    };
+
+    ConcurrentBinarySearchTree() = default;
+
+    explicit ConcurrentBinarySearchTree(const Compare& compare)
+    : m_compare {compare}
+    {
+    }
+
+    // Versions are shared, so neither tree sees the other's later writes.
+    ConcurrentBinarySearchTree(const ConcurrentBinarySearchTree& source)
+    : m_compare {source.m_compare}
+    {
+        m_root.store(source.m_root.load());
+    }
+
+    ConcurrentBinarySearchTree& operator=(const ConcurrentBinarySearchTree& source) = delete;
+
+    /* Takes a consistent, unchanging view of the tree as it is now.
+     * O(1): the root is loaded once and nothing is copied.
+     */
+    Snapshot snapshot() const {
+        return Snapshot{m_root.load(), m_compare};
+    }
+
+    std::size_t size() const { return snapshot().size(); }
+
+    bool contains(const T& value) const { return snapshot().contains(value); }
+
+    std::vector<T> dfsInOrder() const { return snapshot().dfsInOrder(); }
+
+    bool insert(const T& value) {
+        std::lock_guard lock {m_writeLock};
+        bool inserted {false};
+        NodePtr newRoot {__r_insert(m_root.load(), value, inserted)};
+        if (inserted) {m_root.store(std::move(newRoot));}
+        return inserted;
+    }
+
+    void remove(const T& value) {
+        std::lock_guard lock {m_writeLock};
+        bool removed {false};
+        NodePtr newRoot {__r_remove(m_root.load(), value, removed)};
+        if (removed) {m_root.store(std::move(newRoot));}
+    }
+
+    friend std::ostream& operator<< (std::ostream& out, const ConcurrentBinarySearchTree& bst) {
+        out << "ConcurrentBST[ ";
+        for (const T& value : bst.dfsInOrder()) {
+            out << value << " ";
+        }
+        out << "]";
+        return out;
+    }
+
+private:
+    std::atomic<NodePtr> m_root {nullptr};      // the published version
+    std::mutex m_writeLock {};                  // one writer at a time
+    [[no_unique_address]] Compare m_compare {};
+
+    static int __height(const NodePtr& node) {
+        return node ? node -> height : 0;
+    }
+
+    static std::size_t __size(const NodePtr& node) {
+        return node ? node -> size : 0;
+    }
+
+    // Every new Node is built with its final children, so it never changes.
+    static NodePtr __make(T value, NodePtr left, NodePtr right) {
+        int height {1 + std::max(__height(left), __height(right))};
+        std::size_t size {1 + __size(left) + __size(right)};
+        return std::make_shared<const Node>(Node{std::move(value), std::move(left), std::move(right), height, size});
+    }
+
+    /* Rotations and rebalancing build new Nodes rather than relinking old
+     * ones, as the old ones may be in use by readers.
+     *
+     *      x                 y
+     *     / \   rotate     / \
+     *    a   y   left     x   c
+     *       / \  ---->   / \
+     *      b   c        a   b
+     */
+    static NodePtr __rotateLeft(const NodePtr& x) {
+        const NodePtr& y {x -> right};
+        return __make(y -> value, __make(x -> value, x -> left, y -> left), y -> right);
+    }
+
+    static NodePtr __rotateRight(const NodePtr& y) {
+        const NodePtr& x {y -> left};
+        return __make(x -> value, x -> left, __make(y -> value, x -> right, y -> right));
+    }
+
+    // Builds a balanced Node from a value and two subtrees whose heights
+    // differ by at most two.
+    static NodePtr __balance(T value, NodePtr left, NodePtr right) {
+        int balance {__height(left) - __height(right)};
+        if (balance > 1) {
+            if (__height(left -> left) < __height(left -> right)) {left = __rotateLeft(left);}
+            return __rotateRight(__make(std::move(value), std::move(left), std::move(right)));
+        }
+        if (balance < -1) {
+            if (__height(right -> right) < __height(right -> left)) {right = __rotateRight(right);}
+            return __rotateLeft(__make(std::move(value), std::move(left), std::move(right)));
+        }
+        return __make(std::move(value), std::move(left), std::move(right));
+    }
+
+    NodePtr __r_insert(const NodePtr& node, const T& value, bool& inserted) const {
+        if (!node) {
+            inserted = true;
+            return __make(value, nullptr, nullptr);
+        }
+        if (m_compare(value, node -> value)) {
+            NodePtr left {__r_insert(node -> left, value, inserted)};
+            if (!inserted) {return node;}
+            return __balance(node -> value, std::move(left), node -> right);
+        }
+        if (m_compare(node -> value, value)) {
+            NodePtr right {__r_insert(node -> right, value, inserted)};
+            if (!inserted) {return node;}
+            return __balance(node -> value, node -> left, std::move(right));
+        }
+        return node;        // duplicate. Nothing is copied.
+    }
+
+    static const Node* __min(const Node* node) {
+        while (node -> left) {node = node -> left.get();}
+        return node;
+    }
+
+    NodePtr __r_remove(const NodePtr& node, const T& value, bool& removed) const {
+        if (!node) {return nullptr;}
+        if (m_compare(value, node -> value)) {
+            NodePtr left {__r_remove(node -> left, value, removed)};
+            if (!removed) {return node;}
+            return __balance(node -> value, std::move(left), node -> right);
+        }
+        if (m_compare(node -> value, value)) {
+            NodePtr right {__r_remove(node -> right, value, removed)};
+            if (!removed) {return node;}
+            return __balance(node -> value, node -> left, std::move(right));
+        }
+        removed = true;
+        if (!(node -> left)) {return node -> right;}
+        if (!(node -> right)) {return node -> left;}
+        // replace with the successor, removing it from the right subtree
+        const T& successor {__min(node -> right.get()) -> value};
+        bool removedSuccessor {false};
+        NodePtr right {__r_remove(node -> right, successor, removedSuccessor)};
+        return __balance(successor, node -> left, std::move(right));
+    }
+};
+
+} // end namespace sjd
+#endif
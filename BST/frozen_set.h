@@ -0,0 +1,406 @@
+#ifndef FROZEN_SET_H
+#define FROZEN_SET_H
+/* Sam Drew ~ 2025
+ * Frozen (read-only) sorted set implementation in C++
+ * ---
+ *  An immutable snapshot of a sorted set laid out in Eytzinger order. Written
+ *  by me, for my own edification in data structures and algorithms and C++.
+ *
+ *  The Eytzinger layout stores a perfectly balanced binary search tree in one
+ *  flat array in breadth-first order, the same order elementsTopDown() walks
+ *  a tree in. Slot k holds a Node whose children sit in slots 2k and 2k + 1,
+ *  so there are no pointers to chase, the first few levels of the tree share
+ *  a handful of cache lines and the Nodes four levels below the current one
+ *  are contiguous and can be prefetched in one go.
+ *
+ *  Because the layout has no pointers in it, a set of trivially copyable
+ *  values can be saved to a file exactly as it sits in memory and mapped
+ *  straight back in. A mapped set answers queries from the page cache with no
+ *  deserialisation, and every process that maps the same file shares the
+ *  same physical pages.
+ *
+ *  Class templating is used to allow the creation of sets of any object
+ *  type. This version doesn't provide deduction guides so will only compile
+ *  with C++20 or newer.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SJD_FROZEN_SET_MMAP 1
+#endif
+
+namespace sjd {
+
+/* Frozen Set template class.
+ *
+ *  Usually made by calling freeze() on a sjd::BinarySearchTree once it has
+ *  been filled. Copies are cheap and share the same array.
+ *  Values are ordered with Compare, which must match the ordering of the
+ *  values the set is built from. It defaults to std::less<T>.
+ *  Example:
+ *      sjd::BinarySearchTree<int> myTree {};
+ *      myTree.insert(2);
+ *      myTree.insert(1);
+ *      sjd::FrozenSet<int> mySet {myTree.freeze()};    // mySet: [2 1]
+ *      mySet.contains(1);                              // true
+ *      *mySet.lower_bound(0);                          // 1
+ *
+ *      mySet.save("set.bin");
+ *      auto mapped {sjd::FrozenSet<int>::loadMapped("set.bin")};
+ *      mapped -> contains(1);                          // true
+ *
+ *  NOTE: Saved files hold the raw bytes of the values, so they can only be
+ *  read back by a build with the same value type, byte order and Compare.
+ *  The header records enough to reject a file written for a different value
+ *  size or byte order; the Compare can't be checked.
+ */
+template <typename T, typename Compare = std::less<T>>
+class FrozenSet {
+public:
+    FrozenSet()
+    : m_data {}
+    , m_size {0}
+    {
+    }
+
+    // Builds the set from values that are already sorted and unique.
+    explicit FrozenSet(const std::vector<T>& sortedValues, const Compare& compare = Compare{})
+    : m_data {}
+    , m_size {sortedValues.size()}
+    , m_compare {compare}
+    {
+        // slot 0 is unused so that the children of slot k are 2k and 2k + 1
+        auto slots {std::make_shared<std::vector<T>>(m_size + 1)};
+        std::size_t next {0};
+        __r_fill(sortedValues, *slots, next, 1);
+        m_data = std::shared_ptr<const T>(slots, slots -> data());
+    }
+
+    std::size_t size() const { return m_size; }
+
+    // The Eytzinger array. Slot 0 is padding; the values are in 1..size().
+    const T* data() const { return m_data.get(); }
+
+    /* Forward iterator over the values in sorted order. The in-order
+     * successor of slot k is the leftmost slot under its right child or,
+     * without one, the slot reached by climbing past every right turn.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_slots[m_k]; }
+        pointer operator->() const { return m_slots + m_k; }
+
+        const_iterator& operator++() {
+            if (2 * m_k + 1 <= m_size) {
+                m_k = 2 * m_k + 1;
+                while (2 * m_k <= m_size) {m_k = 2 * m_k;}
+            }
+            else {m_k = __finish(m_k);}
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) {
+            return a.m_k == b.m_k;
+        }
+
+    private:
+        friend class FrozenSet;
+
+        const_iterator(const T* slots, std::size_t k, std::size_t size)
+        : m_slots {slots}
+        , m_k {k}
+        , m_size {size}
+        {
+        }
+
+        const T* m_slots {nullptr};
+        std::size_t m_k {0};        // 0 once past the largest value
+        std::size_t m_size {0};
+    };
+    using iterator = const_iterator;
+
+    const_iterator begin() const {
+        std::size_t k {m_size > 0 ? 1u : 0u};
+        while (k > 0 && 2 * k <= m_size) {k = 2 * k;}
+        return {m_data.get(), k, m_size};
+    }
+
+    const_iterator end() const { return {m_data.get(), 0, m_size}; }
+
+    // The values in [low, high) in sorted order.
+    std::ranges::subrange<const_iterator> range(const T& low, const T& high) const {
+        if (!m_compare(low, high)) {return {end(), end()};}
+        return {const_iterator{m_data.get(), __descend(low), m_size},
+                const_iterator{m_data.get(), __descend(high), m_size}};
+    }
+
+    /* Returns a pointer to the smallest value that is not less than the given
+     * value, or nullptr if every value is less.
+     * The descent has no data dependent branches: each level picks a child
+     * with arithmetic, and the bits of k record the path taken. The answer is
+     * the last Node where the path went left, found by stripping the trailing
+     * right turns (1 bits) and the left turn before them.
+     */
+    const T* lower_bound(const T& value) const {
+        std::size_t k {__descend(value)};
+        return (k == 0) ? nullptr : m_data.get() + k;
+    }
+
+    bool contains(const T& value) const {
+        std::size_t k {__descend(value)};
+        return k != 0 && !m_compare(value, m_data.get()[k]);
+    }
+
+    /* Looks up every value in queries and writes whether it was found to the
+     * matching slot of results. Eight searches are run side by side so the
+     * cache misses of one overlap with the work of the others. When compiled
+     * with AVX2 the eight searches over 32-bit integers run in one vector.
+     */
+    void containsBatch(std::span<const T> queries, std::span<bool> results) const {
+        constexpr std::size_t lanes {8};
+        std::size_t i {0};
+        for (; i + lanes <= queries.size(); i += lanes) {
+            std::size_t ks[lanes];
+            __descendBatch(queries.data() + i, ks);
+            for (std::size_t lane {0}; lane < lanes; ++lane) {
+                std::size_t k {__finish(ks[lane])};
+                results[i + lane] = k != 0 && !m_compare(queries[i + lane], m_data.get()[k]);
+            }
+        }
+        for (; i < queries.size(); ++i) {
+            results[i] = contains(queries[i]);
+        }
+    }
+
+    /* Writes the set to a file in the layout it has in memory, behind a
+     * small header. Returns false if the file couldn't be written.
+     */
+    bool save(const std::string& path) const requires std::is_trivially_copyable_v<T> {
+        std::ofstream file {path, std::ios::binary | std::ios::trunc};
+        if (!file) {return false;}
+        FileHeader header {};
+        std::memcpy(header.magic, s_fileMagic, sizeof(header.magic));
+        header.count = m_size;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        // slot 0 is written too, so the file maps straight onto the array
+        std::vector<T> padding(1);
+        const T* slots {m_size > 0 ? m_data.get() : padding.data()};
+        file.write(reinterpret_cast<const char*>(slots),
+                   static_cast<std::streamsize>((m_size + 1) * sizeof(T)));
+        return static_cast<bool>(file.flush());
+    }
+
+    /* Maps a file written by save() read-only into memory and returns a set
+     * that queries it in place. The mapping is released when the last copy
+     * of the set goes. Returns std::nullopt if the file can't be opened or
+     * wasn't written for this value type. Where mmap isn't available the
+     * file is read into memory instead.
+     */
+    static std::optional<FrozenSet> loadMapped(const std::string& path, const Compare& compare = Compare{})
+        requires std::is_trivially_copyable_v<T> {
+#if defined(SJD_FROZEN_SET_MMAP)
+        int fd {::open(path.c_str(), O_RDONLY)};
+        if (fd < 0) {return std::nullopt;}
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        std::size_t length {static_cast<std::size_t>(info.st_size)};
+        void* address {::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0)};
+        ::close(fd);        // the mapping keeps the file open
+        if (address == MAP_FAILED) {return std::nullopt;}
+        std::shared_ptr<const unsigned char> bytes {static_cast<const unsigned char*>(address),
+            [length](const unsigned char* mapped) {
+                ::munmap(const_cast<unsigned char*>(mapped), length);
+            }};
+#else
+        std::ifstream file {path, std::ios::binary | std::ios::ate};
+        if (!file) {return std::nullopt;}
+        std::size_t length {static_cast<std::size_t>(file.tellg())};
+        auto buffer {std::make_shared<std::vector<unsigned char>>(length)};
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer -> data()), static_cast<std::streamsize>(length))) {
+            return std::nullopt;
+        }
+        std::shared_ptr<const unsigned char> bytes {buffer, buffer -> data()};
+#endif
+        if (length < sizeof(FileHeader)) {return std::nullopt;}
+        FileHeader header {};
+        std::memcpy(&header, bytes.get(), sizeof(header));
+        if (std::memcmp(header.magic, s_fileMagic, sizeof(header.magic)) != 0
+            || header.version != s_fileVersion
+            || header.byteOrder != s_byteOrder
+            || header.valueSize != sizeof(T)
+            || header.count >= (length - sizeof(FileHeader)) / sizeof(T)) {
+            return std::nullopt;
+        }
+        FrozenSet set {};
+        set.m_data = std::shared_ptr<const T>(bytes, reinterpret_cast<const T*>(bytes.get() + sizeof(FileHeader)));
+        set.m_size = static_cast<std::size_t>(header.count);
+        set.m_compare = compare;
+        return set;
+    }
+
+    friend std::ostream& operator<< (std::ostream& out, const FrozenSet& set) {
+        out << "FrozenSet[ ";
+        for (std::size_t k {1}; k <= set.m_size; ++k) {
+            out << set.m_data.get()[k] << " ";
+        }
+        out << "]";
+        return out;
+    }
+
+private:
+    std::shared_ptr<const T> m_data {};     // shared, never modified
+    std::size_t m_size {};
+    [[no_unique_address]] Compare m_compare {};
+
+    /* Saved files start with this header, which fills a whole cache line so
+     * the array after it stays aligned for any value type. The bytes after
+     * the fields are spelled out as zeroed reserved space, so no
+     * uninitialised padding is written to the file. Bump s_fileVersion
+     * whenever the layout changes.
+     */
+    struct alignas(64) FileHeader {
+        char magic[8] {};
+        std::uint32_t version {s_fileVersion};
+        std::uint32_t byteOrder {s_byteOrder};      // reads back swapped on the wrong platform
+        std::uint64_t valueSize {sizeof(T)};
+        std::uint64_t count {0};                    // values, not counting slot 0
+        unsigned char reserved[32] {};
+    };
+    static_assert(sizeof(FileHeader) == 64, "FileHeader must have no implicit padding");
+    static constexpr char s_fileMagic[8] {'S', 'J', 'D', 'F', 'R', 'O', 'Z', 'N'};
+    static constexpr std::uint32_t s_fileVersion {1};
+    static constexpr std::uint32_t s_byteOrder {0x01020304};
+    static_assert(alignof(T) <= 64, "Saved values must not need more than cache line alignment");
+
+    // Number of values that fit in one cache line.
+    static constexpr std::size_t s_lineValues {std::max<std::size_t>(64 / sizeof(T), 1)};
+
+    static void __prefetch([[maybe_unused]] const void* address) {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#endif
+    }
+
+    // In-order walk of the implicit tree hands out the sorted values.
+    static void __r_fill(const std::vector<T>& sortedValues, std::vector<T>& slots,
+                         std::size_t& next, std::size_t k) {
+        if (k >= slots.size()) {return;}
+        __r_fill(sortedValues, slots, next, 2 * k);
+        slots[k] = sortedValues[next++];
+        __r_fill(sortedValues, slots, next, 2 * k + 1);
+    }
+
+    static std::size_t __finish(std::size_t k) {
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    std::size_t __descend(const T& value) const {
+        const T* slots {m_data.get()};
+        std::size_t k {1};
+        while (k <= m_size) {
+            // the Nodes four levels down are contiguous; fetch them early
+            __prefetch(slots + k * s_lineValues);
+            k = 2 * k + static_cast<std::size_t>(m_compare(slots[k], value));
+        }
+        return __finish(k);
+    }
+
+    void __descendBatch(const T* queries, std::size_t* ks) const {
+        constexpr std::size_t lanes {8};
+#if defined(__AVX2__)
+        constexpr bool naturalOrder {std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>};
+        if constexpr (naturalOrder && std::is_integral_v<T> && sizeof(T) == 4) {
+            if (m_size < (std::size_t{1} << 30)) {
+                __descendBatchAvx2(queries, ks);
+                return;
+            }
+        }
+#endif
+        const T* slots {m_data.get()};
+        for (std::size_t lane {0}; lane < lanes; ++lane) {ks[lane] = 1;}
+        std::size_t levels {static_cast<std::size_t>(std::bit_width(m_size))};
+        for (std::size_t level {0}; level < levels; ++level) {
+            for (std::size_t lane {0}; lane < lanes; ++lane) {
+                std::size_t k {ks[lane]};
+                if (k <= m_size) {
+                    __prefetch(slots + k * s_lineValues);
+                    ks[lane] = 2 * k + static_cast<std::size_t>(m_compare(slots[k], queries[lane]));
+                }
+            }
+        }
+    }
+
+#if defined(__AVX2__)
+    /* Each of the eight 32-bit lanes follows its own path. Lanes that have
+     * already fallen off the bottom of the tree are masked out of the gather
+     * and keep their k, exactly as the scalar loop would stop.
+     */
+    void __descendBatchAvx2(const T* queries, std::size_t* ks) const {
+        const int* slots {reinterpret_cast<const int*>(m_data.get())};
+        // flipping the sign bit lets a signed compare order unsigned values
+        const __m256i bias {_mm256_set1_epi32(std::is_signed_v<T> ? 0 : INT32_MIN)};
+        const __m256i one {_mm256_set1_epi32(1)};
+        const __m256i size {_mm256_set1_epi32(static_cast<int>(m_size))};
+        __m256i query {_mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(queries)), bias)};
+        __m256i k {one};
+        std::size_t levels {static_cast<std::size_t>(std::bit_width(m_size))};
+        for (std::size_t level {0}; level < levels; ++level) {
+            __m256i active {_mm256_cmpgt_epi32(_mm256_add_epi32(size, one), k)};
+            __m256i slot {_mm256_mask_i32gather_epi32(_mm256_setzero_si256(), slots, k, active, 4)};
+            __m256i goRight {_mm256_and_si256(
+                _mm256_cmpgt_epi32(query, _mm256_xor_si256(slot, bias)), one)};
+            __m256i next {_mm256_add_epi32(_mm256_add_epi32(k, k), goRight)};
+            k = _mm256_blendv_epi8(k, next, active);
+        }
+        alignas(32) std::int32_t out[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out), k);
+        for (std::size_t lane {0}; lane < 8; ++lane) {
+            ks[lane] = static_cast<std::size_t>(out[lane]);
+        }
+    }
+#endif
+};
+
+} // end namespace sjd
+#endif
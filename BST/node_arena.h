@@ -0,0 +1,163 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+/* Sam Drew ~ 2025
+ * Node Arena implementation in C++
+ * ---
+ *  A small slab allocator used by the tree containers to store their Nodes.
+ *  Written by me, for my own edification in data structures and algorithms
+ *  and C++.
+ *
+ *  Nodes are carved out of large contiguous blocks rather than being
+ *  allocated one at a time, so building a tree costs a pointer bump per Node
+ *  instead of a trip to the global allocator and Nodes that were created
+ *  together sit next to each other in memory. Destroyed Nodes are kept on a
+ *  free list and reused by the next create().
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace sjd {
+
+/* Node Arena template class.
+ *
+ *  Owns the memory for every Node it creates. Nodes must be handed back with
+ *  destroy() to run their destructors; any memory still held when the arena
+ *  is cleared or destroyed is released without running destructors.
+ *  Example:
+ *      sjd::NodeArena<Node> arena {};
+ *      Node* node {arena.create(3)};   // Node{3} in the first block
+ *      arena.destroy(node);            // node's slot is now free for reuse
+ */
+template <typename Node>
+class NodeArena {
+    // Each slot either holds a live Node or links to the next free slot.
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+public:
+    NodeArena() = default;
+    ~NodeArena() = default;
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    // Moving hands the blocks over whole, so Nodes keep their addresses.
+    NodeArena(NodeArena&& source) noexcept { swap(source); }
+
+    NodeArena& operator=(NodeArena&& source) noexcept {
+        if (this != &source) {
+            clear();
+            swap(source);
+        }
+        return *this;
+    }
+
+    void swap(NodeArena& other) noexcept {
+        std::swap(m_blocks, other.m_blocks);
+        std::swap(m_free, other.m_free);
+        std::swap(m_bump, other.m_bump);
+        std::swap(m_end, other.m_end);
+        std::swap(m_live, other.m_live);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_nextBlock, other.m_nextBlock);
+    }
+
+    // number of Nodes currently alive in the arena
+    std::size_t size() const { return m_live; }
+
+    // bytes of memory reserved by the arena
+    std::size_t capacityBytes() const { return m_capacity * sizeof(Slot); }
+
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        Slot* slot {m_free};
+        if (slot) {
+            m_free = slot -> next;
+        }
+        else {
+            if (m_bump == m_end) {__grow(m_nextBlock);}
+            slot = m_bump++;
+        }
+        Node* node {::new (static_cast<void*>(slot -> storage)) Node{std::forward<Args>(args)...}};
+        ++m_live;
+        return node;
+    }
+
+    void destroy(Node* node) {
+        if (!node) {return;}
+        node -> ~Node();
+        Slot* slot {reinterpret_cast<Slot*>(node)};
+        slot -> next = m_free;
+        m_free = slot;
+        --m_live;
+    }
+
+    /* Makes sure the next count calls to create() can be served from a single
+     * contiguous block without allocating again.
+     */
+    void reserve(std::size_t count) {
+        std::size_t available {static_cast<std::size_t>(m_end - m_bump)};
+        if (count > available) {__grow(count);}
+    }
+
+    /* Hands out memory for count Nodes in one contiguous run, indexed like an
+     * array from the returned pointer. The Nodes are not constructed: each
+     * must be constructed in place (e.g. with std::construct_at) before use
+     * and is handed back with destroy() as usual. Nothing is shared between
+     * the Nodes of a run, so separate threads may construct separate Nodes.
+     */
+    Node* allocateRun(std::size_t count) {
+        static_assert(sizeof(Slot) == sizeof(Node), "Slots must stride like Nodes");
+        reserve(count);
+        Slot* first {m_bump};
+        m_bump += count;
+        m_live += count;
+        return reinterpret_cast<Node*>(first);
+    }
+
+    /* Releases every block at once. Any Nodes that were not destroyed first
+     * are dropped without having their destructors run.
+     */
+    void clear() {
+        m_blocks.clear();
+        m_free = nullptr;
+        m_bump = nullptr;
+        m_end = nullptr;
+        m_live = 0;
+        m_capacity = 0;
+        m_nextBlock = s_firstBlock;
+    }
+
+private:
+    // Blocks are capped at around a megabyte however large a Node is.
+    static constexpr std::size_t s_maxBlock {std::max<std::size_t>((std::size_t{1} << 20) / sizeof(Slot), 1)};
+    static constexpr std::size_t s_firstBlock {std::min<std::size_t>(64, s_maxBlock)};
+
+    std::vector<std::unique_ptr<Slot[]>> m_blocks {};
+    Slot* m_free {nullptr};         // singly linked list of destroyed slots
+    Slot* m_bump {nullptr};         // next untouched slot in the newest block
+    Slot* m_end {nullptr};          // one past the end of the newest block
+    std::size_t m_live {0};
+    std::size_t m_capacity {0};
+    std::size_t m_nextBlock {s_firstBlock};
+
+    // Blocks double in size up to s_maxBlock so small trees stay small.
+    void __grow(std::size_t count) {
+        std::size_t slots {std::max(count, m_nextBlock)};
+        m_blocks.push_back(std::make_unique_for_overwrite<Slot[]>(slots));
+        m_bump = m_blocks.back().get();
+        m_end = m_bump + slots;
+        m_capacity += slots;
+        m_nextBlock = std::min(m_nextBlock * 2, s_maxBlock);
+    }
+};
+
+} // end namespace sjd
+#endif
@@ -0,0 +1,95 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+/* Sam Drew ~ 2025
+ * Ring Buffer (circular queue) implementation in C++
+ * ---
+ *  A first in, first out queue kept in one contiguous array that wraps
+ *  around. Written by me, for my own edification in data structures and
+ *  algorithms and C++.
+ *
+ *  Unlike sjd::Queue, which allocates a Node for every value it holds, the
+ *  ring buffer only allocates when it has to grow. Its capacity is always a
+ *  power of two so wrapping an index is a single mask, and clear() keeps the
+ *  array, so one buffer can be reused for walk after walk without touching
+ *  the allocator again.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace sjd {
+
+/* Ring Buffer template class.
+ *
+ *  Takes from the front and appends to the back like sjd::Queue. The array
+ *  doubles in size whenever an enqueue finds it full.
+ *  Example:
+ *      sjd::RingBuffer<int> myBuffer {};  // myBuffer: []
+ *      myBuffer.enqueue(3);                // myBuffer: [3]
+ *      myBuffer.enqueue(4);                // myBuffer: [3 4]
+ *      myBuffer.dequeue();                 // 3, myBuffer: [4]
+ *      myBuffer.clear();                   // myBuffer: [], capacity kept
+ *
+ *  NOTE: A Class like this is already implemented in the standard C++ library
+ *  as the std::queue adaptor over std::deque. Prefer to use the standard
+ *  container for all collaborative work.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    RingBuffer() = default;
+
+    std::size_t length() const { return m_length; }
+    bool empty() const { return m_length == 0; }
+    std::size_t capacity() const { return m_slots.size(); }
+
+    // Makes room for count values without growing again.
+    void reserve(std::size_t count) {
+        if (count > m_slots.size()) {__grow(std::bit_ceil(count));}
+    }
+
+    void enqueue(const T& value) {
+        if (m_length == m_slots.size()) {__grow(std::max<std::size_t>(m_slots.size() * 2, s_minCapacity));}
+        m_slots[(m_head + m_length) & (m_slots.size() - 1)] = value;
+        ++m_length;
+    }
+
+    // The queue must not be empty.
+    T dequeue() {
+        T value {std::move(m_slots[m_head])};
+        m_head = (m_head + 1) & (m_slots.size() - 1);
+        --m_length;
+        return value;
+    }
+
+    const T& front() const { return m_slots[m_head]; }
+
+    // Empties the queue but keeps its memory for reuse.
+    void clear() {
+        m_head = 0;
+        m_length = 0;
+    }
+
+private:
+    static constexpr std::size_t s_minCapacity {16};
+
+    std::vector<T> m_slots {};      // size is zero or a power of two
+    std::size_t m_head {0};         // index of the front value
+    std::size_t m_length {0};
+
+    // Unwraps the values into the front of a larger array.
+    void __grow(std::size_t capacity) {
+        std::vector<T> slots(capacity);
+        for (std::size_t i {0}; i < m_length; ++i) {
+            slots[i] = std::move(m_slots[(m_head + i) & (m_slots.size() - 1)]);
+        }
+        m_slots = std::move(slots);
+        m_head = 0;
+    }
+};
+
+} // end namespace sjd
+#endif
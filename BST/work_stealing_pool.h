@@ -0,0 +1,191 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+/* Sam Drew ~ 2025
+ * Work Stealing thread pool implementation in C++
+ * ---
+ *  A small fork-join thread pool used by the tree containers to visit their
+ *  subtrees in parallel. Written by me, for my own edification in data
+ *  structures and algorithms and C++.
+ *
+ *  Every worker owns a double ended queue of tasks. A worker pushes the tasks
+ *  it forks onto the back of its own queue and takes its next task from the
+ *  back too, so it keeps working on the freshest, smallest and most cache
+ *  friendly pieces. A worker that runs dry steals from the front of another
+ *  worker's queue, where the oldest and so largest pieces of work sit. A
+ *  thread waiting for its forked tasks to finish doesn't block; it runs
+ *  queued tasks until they are done, so nested fork-join never deadlocks.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sjd {
+
+/* Work Stealing Pool class.
+ *
+ *  Tasks are forked through a TaskGroup, which waits for every task it ran
+ *  (and every task those forked into it) before wait() returns. Threads
+ *  outside the pool may fork too; their tasks go on a shared queue that the
+ *  workers steal from. Tasks must not throw.
+ *  Example:
+ *      sjd::WorkStealingPool pool {4};             // four worker threads
+ *      sjd::WorkStealingPool::TaskGroup group {pool};
+ *      group.run([] { work(1); });                 // queued for a worker
+ *      group.run([] { work(2); });
+ *      group.wait();                               // helps until both ran
+ */
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads = std::max(std::thread::hardware_concurrency(), 1u))
+    : m_queues {}
+    , m_workers {}
+    {
+        // the last queue is shared by every thread outside the pool
+        for (unsigned i {0}; i <= threads; ++i) {
+            m_queues.push_back(std::make_unique<TaskQueue>());
+        }
+        for (unsigned i {0}; i < threads; ++i) {
+            m_workers.emplace_back([this, i] { __workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard lock {m_sleepLock};
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers) {worker.join();}
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // number of worker threads
+    std::size_t size() const { return m_workers.size(); }
+
+    // A pool with a worker per hardware thread, started on first use.
+    static WorkStealingPool& shared() {
+        static WorkStealingPool pool {};
+        return pool;
+    }
+
+    class TaskGroup {
+    public:
+        explicit TaskGroup(WorkStealingPool& pool)
+        : m_pool {pool}
+        {
+        }
+
+        ~TaskGroup() { wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template <typename Task>
+        void run(Task task) {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+            m_pool.__push([this, task = std::move(task)]() mutable {
+                task();
+                m_pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        // Runs queued tasks, this group's or anyone's, until this group's
+        // tasks have all finished.
+        void wait() {
+            while (m_pending.load(std::memory_order_acquire) > 0) {
+                if (!m_pool.__runOne()) {std::this_thread::yield();}
+            }
+        }
+
+    private:
+        WorkStealingPool& m_pool;
+        std::atomic<std::size_t> m_pending {0};
+    };
+
+private:
+    struct TaskQueue {
+        std::mutex lock {};
+        std::deque<std::function<void()>> tasks {};
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<std::size_t> m_queued {0};      // tasks waiting in any queue
+    std::mutex m_sleepLock {};
+    std::condition_variable m_wake {};
+    bool m_stopping {false};                    // guarded by m_sleepLock
+
+    // which pool the current thread works for, and its queue in that pool
+    static inline thread_local const WorkStealingPool* t_pool {nullptr};
+    static inline thread_local std::size_t t_queue {0};
+
+    std::size_t __ownQueue() const {
+        return (t_pool == this) ? t_queue : m_queues.size() - 1;
+    }
+
+    void __push(std::function<void()> task) {
+        TaskQueue& queue {*m_queues[__ownQueue()]};
+        {
+            std::lock_guard lock {queue.lock};
+            queue.tasks.push_back(std::move(task));
+        }
+        m_queued.fetch_add(1, std::memory_order_release);
+        m_wake.notify_one();
+    }
+
+    /* Takes the newest task from this thread's own queue or, failing that,
+     * the oldest task from the next queue that has one, and runs it.
+     * Returns false if every queue was empty.
+     */
+    bool __runOne() {
+        std::size_t own {__ownQueue()};
+        std::function<void()> task {};
+        for (std::size_t i {0}; i < m_queues.size() && !task; ++i) {
+            TaskQueue& queue {*m_queues[(own + i) % m_queues.size()]};
+            std::lock_guard lock {queue.lock};
+            if (queue.tasks.empty()) {continue;}
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+        if (!task) {return false;}
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    // Idle workers sleep until a task is pushed. The timeout covers a push
+    // that lands between a worker finding nothing and going to sleep.
+    void __workerLoop(std::size_t index) {
+        t_pool = this;
+        t_queue = index;
+        while (true) {
+            if (__runOne()) {continue;}
+            std::unique_lock lock {m_sleepLock};
+            m_wake.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                return m_stopping || m_queued.load(std::memory_order_acquire) > 0;
+            });
+            if (m_stopping) {return;}
+        }
+    }
+};
+
+} // end namespace sjd
+#endif
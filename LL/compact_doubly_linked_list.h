@@ -0,0 +1,622 @@
+#ifndef COMPACT_DOUBLY_LINKED_LIST_H
+#define COMPACT_DOUBLY_LINKED_LIST_H
+/* Sam Drew ~ 2025
+ * Compact Doubly Linked List implementation in C++
+ * ---
+ *  A Doubly Linked List whose Nodes live side by side in one growable slab
+ *  and link to each other by 32-bit index rather than by pointer. Written by
+ *  me, for my own edification in data structures and algorithms and C++.
+ *
+ *  WARNING: Do not use this library in projects. Instead use the standard C++
+ *  std::list.
+ *
+ *  sjd::DoublyLinkedList spends two 64-bit pointers on each value and makes a
+ *  separate heap allocation for every Node, so its Nodes end up wherever the
+ *  allocator put them. Here each slot holds a value and two 32-bit indexes
+ *  into the slab, so an int costs 12 bytes rather than 24 plus the
+ *  allocator's overhead. Deleted slots go on a free list and are reused
+ *  first. When the slab is full it doubles, and the values are moved across
+ *  in list order, so after every growth a walk down the list reads the slab
+ *  front to back and the prefetcher can stream it.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/* Compact Doubly Linked List template class.
+ *  Holds a single object type in a doubly linked list of one or more objects
+ *  (homogenous), with the API of sjd::DoublyLinkedList. As the list owns
+ *  the slab its values live in, get() returns a pointer to the value and
+ *  pop(), popFirst() and remove() move the value out into a std::optional,
+ *  which is empty if there was nothing to take.
+ *  Member function implementations can be found below the class declaration.
+ *  Example:
+ *      sjd::CompactDoublyLinkedList myList {3};    // myList: [3]
+ *      myList.append(4);                           // myList: [3, 4]
+ *      myList.prepend(2);                          // myList: [2, 3, 4]
+ *      myList.insert(1, 5);                        // myList: [2, 5, 3, 4]
+ *      *myList.get(1);                             // 5
+ *      myList.pop();                               // 4, myList: [2, 5, 3]
+ *
+ *  Like a std::vector, growing the slab moves every value, so pointers,
+ *  references and iterators into the list are invalidated by anything that
+ *  adds a value when length() == capacity() and no slot is free; reserve()
+ *  grows it ahead of time. The slab is allocated with Allocator, rebound to
+ *  Slot. A list holds at most 2^31 - 1 values.
+ *
+ *  NOTE: A Class like this is already implemented in the standard C++ library
+ *  as the std::list container. Prefer to use the standard container for all
+ *  collaborative work.
+ */
+namespace sjd {
+template <typename T, typename Allocator = std::allocator<T>>
+class CompactDoublyLinkedList {
+public:
+
+    // Position of a slot in the slab. s_none ends the list and the free list.
+    using Index = std::uint32_t;
+    static constexpr Index s_none {std::numeric_limits<Index>::max()};
+
+    // A value and its links. The value is only alive while the slot is on
+    // the list; a free slot's next links it into the free list.
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Index next;
+        Index prev;
+
+        T* address() { return reinterpret_cast<T*>(storage); }
+        T& value() { return *std::launder(address()); }
+        const T& value() const { return *std::launder(reinterpret_cast<const T*>(storage)); }
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+    /* Bidirectional iterator over the values in the list. Const iterators
+     * give read-only access to the values; iterators convert to them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using List = std::conditional_t<Const, const CompactDoublyLinkedList, CompactDoublyLinkedList>;
+
+        Iterator() = default;
+        Iterator(Index index, List* list) : m_index {index}, m_list {list} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_index, m_list}; }
+
+        reference operator*() const { return m_list -> m_slots[m_index].value(); }
+        pointer operator->() const { return &(m_list -> m_slots[m_index].value()); }
+
+        Iterator& operator++() {
+            m_index = m_list -> m_slots[m_index].next;
+            return *this;
+        }
+
+        // Stepping back from end() lands on the tail.
+        Iterator& operator--() {
+            m_index = (m_index == s_none) ? m_list -> m_tail : m_list -> m_slots[m_index].prev;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        Iterator operator--(int) {
+            Iterator old {*this};
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+
+    private:
+        Index m_index {s_none};     // s_none at end()
+        List* m_list {nullptr};
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // accessors
+    T* head() { return m_head == s_none ? nullptr : &(m_slots[m_head].value()); }
+    T* tail() { return m_tail == s_none ? nullptr : &(m_slots[m_tail].value()); }
+    const T* head() const { return m_head == s_none ? nullptr : &(m_slots[m_head].value()); }
+    const T* tail() const { return m_tail == s_none ? nullptr : &(m_slots[m_tail].value()); }
+    iterator begin() { return {m_head, this}; }
+    iterator end() { return {s_none, this}; }
+    const_iterator begin() const { return {m_head, this}; }
+    const_iterator end() const { return {s_none, this}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+    int length() const { return m_length; }
+    std::size_t capacity() const { return m_capacity; }
+    // bytes of memory held by the slab
+    std::size_t capacityBytes() const { return static_cast<std::size_t>(m_capacity) * sizeof(Slot); }
+    Allocator get_allocator() const { return Allocator(m_allocator); }
+
+    // constructor and destructor
+    explicit CompactDoublyLinkedList(const T& value, const Allocator& allocator = Allocator{});
+    explicit CompactDoublyLinkedList(T&& value, const Allocator& allocator = Allocator{});
+    ~CompactDoublyLinkedList();
+
+    // Copy constructor
+    void deepCopy(const CompactDoublyLinkedList& source);
+    CompactDoublyLinkedList(const CompactDoublyLinkedList& source)
+    : m_allocator {SlotTraits::select_on_container_copy_construction(source.m_allocator)}
+    {
+        deepCopy(source);
+    }
+
+    // Move constructor. Takes the source's slab and leaves it empty.
+    CompactDoublyLinkedList(CompactDoublyLinkedList&& source) noexcept
+    : m_allocator {std::move(source.m_allocator)}
+    , m_slots {std::exchange(source.m_slots, nullptr)}
+    , m_capacity {std::exchange(source.m_capacity, 0)}
+    , m_used {std::exchange(source.m_used, 0)}
+    , m_free {std::exchange(source.m_free, s_none)}
+    , m_head {std::exchange(source.m_head, s_none)}
+    , m_tail {std::exchange(source.m_tail, s_none)}
+    , m_length {std::exchange(source.m_length, 0)}
+    {
+    }
+
+    void printList() const;
+
+    bool reserve(std::size_t count);
+
+    bool append(const T& value) { return emplace_back(value); }
+    bool append(T&& value) { return emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    bool emplace_back(Args&&... args);
+
+    bool prepend(const T& value) { return emplace_front(value); }
+    bool prepend(T&& value) { return emplace_front(std::move(value)); }
+
+    template <typename... Args>
+    bool emplace_front(Args&&... args);
+
+    std::optional<T> pop();
+
+    std::optional<T> popFirst();
+
+    T* get(int index);
+
+    const T* get(int index) const;
+
+    bool setValue(int index, const T& value);
+
+    bool insert(int index, const T& value) { return emplace(index, value); }
+    bool insert(int index, T&& value) { return emplace(index, std::move(value)); }
+
+    template <typename... Args>
+    bool emplace(int index, Args&&... args);
+
+    std::optional<T> remove(int index);
+
+    CompactDoublyLinkedList& operator=(const CompactDoublyLinkedList& source);
+
+    CompactDoublyLinkedList& operator=(CompactDoublyLinkedList&& source)
+        noexcept(SlotTraits::propagate_on_container_move_assignment::value || SlotTraits::is_always_equal::value);
+
+    void swap(CompactDoublyLinkedList& other) noexcept;
+    friend void swap(CompactDoublyLinkedList& a, CompactDoublyLinkedList& b) noexcept { a.swap(b); }
+
+private:
+
+    static constexpr std::size_t s_firstCapacity {16};
+    // As many values as length() can count: 2^31 - 1
+    static constexpr std::size_t s_maxLength {static_cast<std::size_t>(std::numeric_limits<int>::max())};
+
+    [[no_unique_address]] SlotAllocator m_allocator {};
+    Slot* m_slots {nullptr};
+    Index m_capacity {0};
+    Index m_used {0};           // slots from here on have never been handed out
+    Index m_free {s_none};      // first slot of the free list
+    Index m_head {s_none};
+    Index m_tail {s_none};
+    int m_length {};
+
+    template <typename... Args>
+    Index __createSlot(Args&&... args);
+    void __destroySlot(Index index);
+    Index __find(int index) const;
+    void __link(Index index, Index before);
+    void __unlink(Index index);
+    std::optional<T> __take(Index index);
+    bool __grow(std::size_t count);
+    void __clear();
+
+};
+
+template <typename T, typename Allocator>
+CompactDoublyLinkedList<T, Allocator>::CompactDoublyLinkedList(const T& value, const Allocator& allocator)
+    : m_allocator { allocator }
+{
+    if (!append(value)) {
+        std::cout << "Could not allocate memory!\n";
+    }
+}
+
+template <typename T, typename Allocator>
+CompactDoublyLinkedList<T, Allocator>::CompactDoublyLinkedList(T&& value, const Allocator& allocator)
+    : m_allocator { allocator }
+{
+    if (!append(std::move(value))) {
+        std::cout << "Could not allocate memory!\n";
+    }
+}
+
+template <typename T, typename Allocator>
+CompactDoublyLinkedList<T, Allocator>::~CompactDoublyLinkedList() {
+    __clear();
+}
+
+/*  O(n + m)
+ *  Releases the slab, then copies the m values of the source into a new
+ *  slab just big enough for them, in list order. Stops copying if memory
+ *  runs out. */
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::deepCopy(const CompactDoublyLinkedList& source){
+
+    __clear();
+
+    if (!reserve(static_cast<std::size_t>(source.m_length))) {
+        return;
+    }
+    for (const T& value : source) {
+        append(value);
+    }
+}
+
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::printList() const {
+    for (const T& value : *this) {
+        std::cout << value << "\n";
+    }
+}
+
+/*  O(n)
+ *  Grows the slab to hold at least count values, moving the values across
+ *  in list order. Returns false if memory runs out or count is too big. */
+template <typename T, typename Allocator>
+bool CompactDoublyLinkedList<T, Allocator>::reserve(std::size_t count){
+    if (count <= m_capacity) {
+        return true;
+    }
+    return __grow(count);
+}
+
+/*  O(1) amortised
+ *  Uses the tail index to add a slot, with its value built from args, to
+ *  the end of the list. O(n) when the slab has to grow. */
+template <typename T, typename Allocator>
+template <typename... Args>
+bool CompactDoublyLinkedList<T, Allocator>::emplace_back(Args&&... args) {
+    Index index {__createSlot(std::forward<Args>(args)...)};
+    if (index == s_none) {
+        std::cout << "Could not allocate memory!\n";
+        return false;
+    }
+    __link(index, s_none);
+    return true;
+}
+
+/*  O(1) amortised
+ *  Uses the head index to add a slot, with its value built from args, to
+ *  the beginning of the list. O(n) when the slab has to grow. */
+template <typename T, typename Allocator>
+template <typename... Args>
+bool CompactDoublyLinkedList<T, Allocator>::emplace_front(Args&&... args) {
+    Index index {__createSlot(std::forward<Args>(args)...)};
+    if (index == s_none) {
+        std::cout << "Could not allocate memory!\n";
+        return false;
+    }
+    __link(index, m_head);
+    return true;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> CompactDoublyLinkedList<T, Allocator>::pop(){
+    return __take(m_tail);
+}
+
+template <typename T, typename Allocator>
+std::optional<T> CompactDoublyLinkedList<T, Allocator>::popFirst(){
+    return __take(m_head);
+}
+
+template <typename T, typename Allocator>
+T* CompactDoublyLinkedList<T, Allocator>::get(int index){
+    Index found {__find(index)};
+    return found == s_none ? nullptr : &(m_slots[found].value());
+}
+
+template <typename T, typename Allocator>
+const T* CompactDoublyLinkedList<T, Allocator>::get(int index) const {
+    Index found {__find(index)};
+    return found == s_none ? nullptr : &(m_slots[found].value());
+}
+
+template <typename T, typename Allocator>
+bool CompactDoublyLinkedList<T, Allocator>::setValue(int index, const T& value){
+    T* temp {get(index)};
+    if ( temp ) {
+        *temp = value;
+        return true;
+    }
+    return false;
+}
+
+/*  O(n)
+ *  Builds a value from args in a new slot before the given index, walking
+ *  from whichever end of the list is nearer. */
+template <typename T, typename Allocator>
+template <typename... Args>
+bool CompactDoublyLinkedList<T, Allocator>::emplace(int index, Args&&... args){
+    if (index < 0 || index > m_length) {
+        return false;
+    }
+    Index slot {__createSlot(std::forward<Args>(args)...)};
+    if (slot == s_none) {
+        std::cout << "Could not allocate memory!\n";
+        return false;
+    }
+    // found after creating the slot, as growing the slab renumbers them all
+    __link(slot, index == m_length ? s_none : __find(index));
+    return true;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> CompactDoublyLinkedList<T, Allocator>::remove(int index){
+    return __take(__find(index));
+}
+
+template <typename T, typename Allocator>
+CompactDoublyLinkedList<T, Allocator>& CompactDoublyLinkedList<T, Allocator>::operator=(const CompactDoublyLinkedList& source){
+    if (this != &source) {
+        if constexpr (SlotTraits::propagate_on_container_copy_assignment::value) {
+            __clear();
+            m_allocator = source.m_allocator;
+        }
+        deepCopy(source);
+    }
+    return *this;
+}
+
+/*  Move assignment. Takes the source's slab and leaves it empty, unless the
+ *  two lists' allocators differ and can't be swapped. The slab can't change
+ *  allocator, so then the values are moved across one at a time. */
+template <typename T, typename Allocator>
+CompactDoublyLinkedList<T, Allocator>& CompactDoublyLinkedList<T, Allocator>::operator=(CompactDoublyLinkedList&& source)
+    noexcept(SlotTraits::propagate_on_container_move_assignment::value || SlotTraits::is_always_equal::value){
+    if (this == &source) {
+        return *this;
+    }
+    __clear();
+    if constexpr (SlotTraits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(source.m_allocator);
+    }
+    else if constexpr (!SlotTraits::is_always_equal::value) {
+        if (m_allocator != source.m_allocator) {
+            reserve(static_cast<std::size_t>(source.m_length));
+            for (T& value : source) {
+                emplace_back(std::move(value));
+            }
+            source.__clear();
+            return *this;
+        }
+    }
+    swap(source);
+    return *this;
+}
+
+//  Swaps the slabs of two lists. Their allocators must be equal or propagate.
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::swap(CompactDoublyLinkedList& other) noexcept{
+    if constexpr (SlotTraits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, other.m_allocator);
+    }
+    std::swap(m_slots, other.m_slots);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_used, other.m_used);
+    std::swap(m_free, other.m_free);
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_length, other.m_length);
+}
+
+/*  Takes a slot off the free list, or the next slot never handed out, and
+ *  builds its value from args. Grows the slab if neither is left. The slot
+ *  isn't linked into the list yet. Returns s_none if memory runs out or the
+ *  list already holds s_maxLength values. */
+template <typename T, typename Allocator>
+template <typename... Args>
+typename CompactDoublyLinkedList<T, Allocator>::Index CompactDoublyLinkedList<T, Allocator>::__createSlot(Args&&... args){
+    if (static_cast<std::size_t>(m_length) >= s_maxLength) {
+        return s_none;
+    }
+    if (m_free == s_none && m_used == m_capacity) {
+        // args may refer to a value in the slab, which growing moves, so the
+        // new value is built first
+        T value(std::forward<Args>(args)...);
+        std::size_t wanted {m_capacity == 0 ? s_firstCapacity : 2 * static_cast<std::size_t>(m_capacity)};
+        wanted = std::min(wanted, s_maxLength);
+        if (!__grow(wanted) && !__grow(static_cast<std::size_t>(m_capacity) + 1)) {
+            return s_none;
+        }
+        return __createSlot(std::move(value));
+    }
+    // the slot is only claimed once its value is built, so a constructor
+    // that throws leaves it free
+    Index index {m_free != s_none ? m_free : m_used};
+    SlotTraits::construct(m_allocator, m_slots[index].address(), std::forward<Args>(args)...);
+    if (index == m_free) {
+        m_free = m_slots[index].next;
+    } else {
+        ++m_used;
+    }
+    return index;
+}
+
+// Destroys the slot's value and puts the slot on the free list.
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::__destroySlot(Index index){
+    SlotTraits::destroy(m_allocator, m_slots[index].address());
+    m_slots[index].next = m_free;
+    m_free = index;
+}
+
+// The slot at the given position, walking from the nearer end, or s_none.
+template <typename T, typename Allocator>
+typename CompactDoublyLinkedList<T, Allocator>::Index CompactDoublyLinkedList<T, Allocator>::__find(int index) const {
+    if (index < 0 || index >= m_length) {
+        return s_none;
+    }
+    Index temp {};
+    if (index < (m_length / 2)) {
+        temp = m_head;
+        for (; index > 0; --index) {
+            temp = m_slots[temp].next;
+        }
+    } else {
+        temp = m_tail;
+        for (; index < (m_length - 1); ++index) {
+            temp = m_slots[temp].prev;
+        }
+    }
+    return temp;
+}
+
+// Links a new slot in just before the slot before, or at the end if s_none.
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::__link(Index index, Index before){
+    Slot& slot {m_slots[index]};
+    slot.next = before;
+    slot.prev = (before == s_none) ? m_tail : m_slots[before].prev;
+    if (slot.prev == s_none) {
+        m_head = index;
+    } else {
+        m_slots[slot.prev].next = index;
+    }
+    if (before == s_none) {
+        m_tail = index;
+    } else {
+        m_slots[before].prev = index;
+    }
+    ++m_length;
+}
+
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::__unlink(Index index){
+    Slot& slot {m_slots[index]};
+    if (slot.prev == s_none) {
+        m_head = slot.next;
+    } else {
+        m_slots[slot.prev].next = slot.next;
+    }
+    if (slot.next == s_none) {
+        m_tail = slot.prev;
+    } else {
+        m_slots[slot.next].prev = slot.prev;
+    }
+    --m_length;
+}
+
+// Moves the value out of a slot, then unlinks and frees the slot.
+template <typename T, typename Allocator>
+std::optional<T> CompactDoublyLinkedList<T, Allocator>::__take(Index index){
+    if (index == s_none) {
+        return std::nullopt;
+    }
+    std::optional<T> value {std::move(m_slots[index].value())};
+    __unlink(index);
+    __destroySlot(index);
+    return value;
+}
+
+/*  O(n)
+ *  Moves the values into a new slab of count slots in list order, so the
+ *  list reads front to back through it, and frees the old slab. The free
+ *  list is left empty and every slot after the values is unused. Returns
+ *  false, leaving the list as it was, if memory runs out or count is too
+ *  big. */
+template <typename T, typename Allocator>
+bool CompactDoublyLinkedList<T, Allocator>::__grow(std::size_t count){
+    if (count > s_maxLength || count <= m_capacity) {
+        return false;
+    }
+    Slot* slots {nullptr};
+    try {
+        slots = SlotTraits::allocate(m_allocator, count);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    Index moved {0};
+    for (Index temp {m_head}; temp != s_none; ++moved) {
+        Slot& old {m_slots[temp]};
+        SlotTraits::construct(m_allocator, slots[moved].address(), std::move(old.value()));
+        SlotTraits::destroy(m_allocator, old.address());
+        slots[moved].prev = (moved == 0) ? s_none : moved - 1;
+        slots[moved].next = moved + 1;
+        temp = old.next;
+    }
+    if (moved > 0) {
+        slots[moved - 1].next = s_none;
+    }
+    if (m_slots) {
+        SlotTraits::deallocate(m_allocator, m_slots, m_capacity);
+    }
+    m_slots = slots;
+    m_capacity = static_cast<Index>(count);
+    m_used = moved;
+    m_free = s_none;
+    m_head = (moved > 0) ? 0 : s_none;
+    m_tail = (moved > 0) ? moved - 1 : s_none;
+    return true;
+}
+
+// Destroys every value, frees the slab and leaves the list empty.
+template <typename T, typename Allocator>
+void CompactDoublyLinkedList<T, Allocator>::__clear(){
+    for (Index temp {m_head}; temp != s_none; temp = m_slots[temp].next) {
+        SlotTraits::destroy(m_allocator, m_slots[temp].address());
+    }
+    if (m_slots) {
+        SlotTraits::deallocate(m_allocator, m_slots, m_capacity);
+    }
+    m_slots = nullptr;
+    m_capacity = 0;
+    m_used = 0;
+    m_free = s_none;
+    m_head = s_none;
+    m_tail = s_none;
+    m_length = 0;
+}
+
+} // end namespace sjd
+#endif
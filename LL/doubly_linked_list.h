@@ -15,8 +15,18 @@
  *  newer.
  */
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /* Doubly Linked List template class.
  *  Holds a single object type in a doubly linked list of one or more objects
@@ -30,13 +40,30 @@
  *      myList.append(4);                   // myList: [3, 4]
  *      myList.prepend(2);                  // myList: [2, 3, 4]
  *      myList.set(1, 1);                   // myList: [2, 1, 4]
+ *      std::ranges::reverse(myList);       // myList: [4, 1, 2]
+ *
+ *  begin() and end() give bidirectional iterators over the values, with
+ *  end() one past the last; head() and tail() give the first and last Nodes.
+ *  Nodes are allocated with Allocator, rebound to Node. std::allocator is
+ *  the default; sjd::PoolAllocator (node_pool.h) serves them from a
+ *  per-thread pool, for containers that stay on one thread.
+ *  Nodes taken off the list come back as a NodeHandle, which hands the Node
+ *  back to the allocator when it goes out of scope.
+ *  Values passed as rvalues are moved into their Nodes, and the emplace
+ *  functions build a value straight into its Node from the arguments for
+ *  its constructor. Moving or swapping a whole list just hands its Nodes
+ *  over.
+ *  sort(), merge(), unique() and splice() only relink the Nodes already in
+ *  the lists, so they never allocate and never copy or move a value.
+ *  After a lot of inserts and removes the Nodes end up all over the heap;
+ *  compact() moves them into fresh memory in list order so scans run fast.
  *
  *  NOTE: A Class like this is already implemented in the standard C++ library 
  *  as the std::list container. Prefer to use the standard container for all 
  *  collaborative work. 
  */
 namespace sjd {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class DoublyLinkedList {
 public:
     
@@ -46,38 +73,151 @@ public:
         Node* next {nullptr};
         Node* prev {nullptr};
 
+        // Builds the value straight from args, whatever T's constructors are.
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+        // Nodes stay where they were allocated and are never copied.
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
+
+    };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    // Returns a Node taken off the list to the list's allocator.
+    struct NodeDeleter {
+        [[no_unique_address]] NodeAllocator allocator {};
+        void operator()(Node* node) {
+            NodeTraits::destroy(allocator, node);
+            NodeTraits::deallocate(allocator, node, 1);
+        }
+    };
+    using NodeHandle = std::unique_ptr<Node, NodeDeleter>;
+
+    /* Bidirectional iterator over the values in the list. Const iterators
+     * give read-only access to the values; iterators convert to them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        Iterator(Node* node, const DoublyLinkedList* list) : m_node {node}, m_list {list} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_node, m_list}; }
+
+        reference operator*() const { return m_node -> value; }
+        pointer operator->() const { return &(m_node -> value); }
+
+        Iterator& operator++() {
+            m_node = m_node -> next;
+            return *this;
+        }
+
+        // Stepping back from end() lands on the tail.
+        Iterator& operator--() {
+            m_node = m_node ? m_node -> prev : m_list -> m_tail;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        Iterator operator--(int) {
+            Iterator old {*this};
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_node == other.m_node; }
+
+        Node* node() const { return m_node; }
+
+    private:
+        Node* m_node {nullptr};                     // nullptr at end()
+        const DoublyLinkedList* m_list {nullptr};   // lets end() step back
     };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     // accessors
-    Node* begin() const { return m_head; }
-    Node* end() const { return m_tail; }
-    int length() const { return m_tail; }
+    Node* head() const { return m_head; }
+    Node* tail() const { return m_tail; }
+    iterator begin() { return {m_head, this}; }
+    iterator end() { return {nullptr, this}; }
+    const_iterator begin() const { return {m_head, this}; }
+    const_iterator end() const { return {nullptr, this}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+    int length() const { return m_length; }
+    Allocator get_allocator() const { return Allocator(m_allocator); }
 
     // constructor and destructor
-    explicit DoublyLinkedList(const T& value);
+    explicit DoublyLinkedList(const T& value, const Allocator& allocator = Allocator{});
+    explicit DoublyLinkedList(T&& value, const Allocator& allocator = Allocator{});
     ~DoublyLinkedList();
 
     // Copy constructor
     void deepCopy(const DoublyLinkedList& source);
-    DoublyLinkedList(const DoublyLinkedList& source) { deepCopy(source); }
+    DoublyLinkedList(const DoublyLinkedList& source)
+    : m_allocator {NodeTraits::select_on_container_copy_construction(source.m_allocator)}
+    {
+        deepCopy(source);
+    }
+
+    // Move constructor. Takes the source's Nodes and leaves it empty.
+    DoublyLinkedList(DoublyLinkedList&& source) noexcept
+    : m_allocator {std::move(source.m_allocator)}
+    , m_head {std::exchange(source.m_head, nullptr)}
+    , m_tail {std::exchange(source.m_tail, nullptr)}
+    , m_length {std::exchange(source.m_length, 0)}
+    {
+    }
 
     void printList() const;
 
-    bool append(const T& value);
+    bool append(const T& value) { return emplace_back(value); }
+    bool append(T&& value) { return emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    bool emplace_back(Args&&... args);
+
+    bool prepend(const T& value) { return emplace_front(value); }
+    bool prepend(T&& value) { return emplace_front(std::move(value)); }
 
-    bool prepend(const T& value);
+    template <typename... Args>
+    bool emplace_front(Args&&... args);
 
-    Node* pop();
+    NodeHandle pop();
 
-    Node* popFirst();
+    NodeHandle popFirst();
 
     Node* get(int index);
 
     bool setValue(int index, const T& value);
 
-    bool insert(int index, const T& value);
+    bool insert(int index, const T& value) { return emplace(index, value); }
+    bool insert(int index, T&& value) { return emplace(index, std::move(value)); }
 
-    Node* remove(int index);
+    template <typename... Args>
+    bool emplace(int index, Args&&... args);
+
+    NodeHandle remove(int index);
 
     bool swapFirstLast();
 
@@ -85,19 +225,80 @@ public:
 
     bool isPalindrome();
 
+    template <typename Compare = std::less<>>
+    void sort(Compare compare = Compare{});
+
+    template <typename Compare = std::less<>>
+    void merge(DoublyLinkedList& other, Compare compare = Compare{});
+
+    template <typename BinaryPredicate = std::equal_to<>>
+    int unique(BinaryPredicate equal = BinaryPredicate{});
+
+    void splice(DoublyLinkedList& other);
+
+    bool splice(int index, DoublyLinkedList& other);
+
+    /* How well the Nodes are laid out for a walk down the list. A link is
+     * near when the next Node starts at most s_nearBytes past the end of
+     * the Node before it, close enough for the hardware prefetcher to have
+     * it ready. */
+    struct Locality {
+        std::size_t links {0};      // next pointers between Nodes
+        std::size_t nearLinks {0};  // links to a Node just after this one
+    };
+
+    Locality locality() const;
+
+    struct CompactStats {
+        std::size_t nodesMoved {0};
+        std::size_t bytesMoved {0};     // nodesMoved * sizeof(Node)
+        Locality before {};
+        Locality after {};
+    };
+
+    CompactStats compact();
+
     DoublyLinkedList& operator=(const DoublyLinkedList& source);
 
+    DoublyLinkedList& operator=(DoublyLinkedList&& source)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value);
+
+    void swap(DoublyLinkedList& other) noexcept;
+    friend void swap(DoublyLinkedList& a, DoublyLinkedList& b) noexcept { a.swap(b); }
+
 private:
 
+    [[no_unique_address]] NodeAllocator m_allocator {};
     Node* m_head {nullptr};
     Node* m_tail {nullptr};
     int m_length {};
 
+    // A sorted chain of Nodes ending in nullptr, with its last Node.
+    struct Run {
+        Node* head {nullptr};
+        Node* tail {nullptr};
+    };
+
+    // One run of 2^i Nodes per bin is enough for any int length.
+    static constexpr std::size_t s_sortBins {64};
+
+    // How far past a Node the next one can start and still count as near.
+    static constexpr std::uintptr_t s_nearBytes {256};
+
+    template <typename... Args>
+    Node* __createNode(Args&&... args);
+    void __destroyNode(Node* node);
+    NodeHandle __handle(Node* node);
+    void __clear();
+    template <typename Compare>
+    static Run __mergeRuns(Run left, Run right, Compare& compare);
+
 };
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(const T& value)
-    : m_head    { new (std::nothrow) Node{value} }
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(const T& value, const Allocator& allocator)
+    : m_allocator { allocator }
+    , m_head    { __createNode(value) }
     , m_tail    { m_head }
     , m_length  { 1 }
 {
@@ -107,44 +308,43 @@ DoublyLinkedList<T>::DoublyLinkedList(const T& value)
     }
 }
 
-template <typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
-    Node* temp {m_head};
-    while(m_head) {
-        m_head = m_head->next;
-        delete temp;
-        temp = m_head;
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(T&& value, const Allocator& allocator)
+    : m_allocator { allocator }
+    , m_head    { __createNode(std::move(value)) }
+    , m_tail    { m_head }
+    , m_length  { 1 }
+{
+    if (!m_head) {
+        m_length = 0;
+        std::cout << "Could not allocate memory!\n";
     }
 }
 
-template <typename T>
-void DoublyLinkedList<T>::deepCopy(const DoublyLinkedList& source){
-
-    delete m_head;
-    delete m_tail;
-
-    m_length = source.m_length;
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
+    __clear();
+}
 
-    if (source.m_head) {
+/*  O(n + m)
+ *  Releases every Node in this list, then copies the m values of the source
+ *  into new Nodes. Stops copying if memory runs out. */
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::deepCopy(const DoublyLinkedList& source){
 
-        m_head = new Node{source.m_head -> value};
-        m_tail = m_head;
-        Node* sourceTemp {source.m_head -> next};
+    __clear();
 
-        while (sourceTemp) {
-            m_tail -> next = new Node {sourceTemp -> value, nullptr, m_tail};
-            sourceTemp = sourceTemp -> next;
-            m_tail = m_tail -> next;
+    Node* sourceTemp {source.m_head};
+    while (sourceTemp) {
+        if (!append(sourceTemp -> value)) {
+            return;
         }
-    }
-    else {
-        m_head = nullptr;
-        m_tail = nullptr;
+        sourceTemp = sourceTemp -> next;
     }
 }
 
-template <typename T>
-void DoublyLinkedList<T>::printList() const {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::printList() const {
     Node* temp {m_head};
     while(temp){
         std::cout << temp->value << "\n";
@@ -153,11 +353,13 @@ void DoublyLinkedList<T>::printList() const {
 }
 
 /*  O(1)
- *  Uses the tail pointer to add the given node value to the end of the list
+ *  Uses the tail pointer to add a node, with its value built from args, to
+ *  the end of the list
  */
-template <typename T>
-bool DoublyLinkedList<T>::append(const T& value) {
-    Node* newNode {new (std::nothrow) Node {value}};
+template <typename T, typename Allocator>
+template <typename... Args>
+bool DoublyLinkedList<T, Allocator>::emplace_back(Args&&... args) {
+    Node* newNode {__createNode(std::forward<Args>(args)...)};
     if (!newNode) {
         std::cout << "Could not allocate memory!\n";
         return false;
@@ -174,17 +376,19 @@ bool DoublyLinkedList<T>::append(const T& value) {
 }
 
 /*  O(1)
- *  Uses the head pointer and its prev pointer to add the new node to the 
- *  beginning of the list. */
-template <typename T>
-bool DoublyLinkedList<T>::prepend(const T& value) {
-    Node* newNode {new (std::nothrow) Node {value}};
+ *  Uses the head pointer and its prev pointer to add the new node, with its
+ *  value built from args, to the beginning of the list. */
+template <typename T, typename Allocator>
+template <typename... Args>
+bool DoublyLinkedList<T, Allocator>::emplace_front(Args&&... args) {
+    Node* newNode {__createNode(std::forward<Args>(args)...)};
     if (!newNode) {
         std::cout << "Could not allocate memory!\n";
         return false;
     }
     if (m_length == 0) {
         m_head = newNode;
+        m_tail = newNode;
     } else {
         m_head -> prev = newNode;
         newNode -> next = m_head;
@@ -194,11 +398,11 @@ bool DoublyLinkedList<T>::prepend(const T& value) {
     return true;
 }
 
-template <typename T>
-DoublyLinkedList<T>::Node* DoublyLinkedList<T>::pop(){
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::NodeHandle DoublyLinkedList<T, Allocator>::pop(){
 
     if ( m_length == 0 ) {
-        return nullptr;
+        return __handle(nullptr);
     }
     Node* temp { m_tail };
     m_tail = m_tail -> prev;
@@ -212,14 +416,14 @@ DoublyLinkedList<T>::Node* DoublyLinkedList<T>::pop(){
     }
     --m_length;
 
-    return temp;
+    return __handle(temp);
 }
 
-template <typename T>
-DoublyLinkedList<T>::Node* DoublyLinkedList<T>::popFirst(){
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::NodeHandle DoublyLinkedList<T, Allocator>::popFirst(){
 
     if ( m_length == 0 ) {
-        return nullptr;
+        return __handle(nullptr);
     }
     Node* temp { m_head };
     m_head = m_head -> next;
@@ -231,11 +435,11 @@ DoublyLinkedList<T>::Node* DoublyLinkedList<T>::popFirst(){
     }
     --m_length;
 
-    return temp;
+    return __handle(temp);
 }
 
-template <typename T>
-DoublyLinkedList<T>::Node* DoublyLinkedList<T>::get(int index){
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Node* DoublyLinkedList<T, Allocator>::get(int index){
     if (index < 0 || index >= m_length) {
         return nullptr;
     }
@@ -256,8 +460,8 @@ DoublyLinkedList<T>::Node* DoublyLinkedList<T>::get(int index){
     }
 }
 
-template <typename T>
-bool DoublyLinkedList<T>::setValue(int index, const T& value){
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::setValue(int index, const T& value){
     if (index < 0 || index >= m_length) {
         return false;
     }
@@ -269,24 +473,30 @@ bool DoublyLinkedList<T>::setValue(int index, const T& value){
     return false;
 }
 
-template <typename T>
-bool DoublyLinkedList<T>::insert(int index, const T& value){
-    if (index < 0 || index >= m_length) {
+/*  O(n)
+ *  Builds a value from args in a new node before the given index, walking
+ *  from whichever end of the list is nearer. */
+template <typename T, typename Allocator>
+template <typename... Args>
+bool DoublyLinkedList<T, Allocator>::emplace(int index, Args&&... args){
+    if (index < 0 || index > m_length) {
         return false;
     }
     if (index == 0) {
-        return prepend(value);
+        return emplace_front(std::forward<Args>(args)...);
     }
     if (index == m_length) {
-        return append(value);
+        return emplace_back(std::forward<Args>(args)...);
     }
     Node* temp {get(index)};
     if ( temp ) {
-        Node* newNode {new (std::nothrow) Node {value, temp, temp -> prev}};
+        Node* newNode {__createNode(std::forward<Args>(args)...)};
         if (!newNode) {
             std::cout << "Could not allocate memory!\n";
             return false;
         }
+        newNode -> next = temp;
+        newNode -> prev = temp -> prev;
         temp -> prev -> next = newNode;
         temp -> prev = newNode;
         ++m_length;
@@ -295,8 +505,14 @@ bool DoublyLinkedList<T>::insert(int index, const T& value){
     return false;
 }
 
-template <typename T>
-DoublyLinkedList<T>::Node* DoublyLinkedList<T>::remove(int index){
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::NodeHandle DoublyLinkedList<T, Allocator>::remove(int index){
+    if (index == 0) {
+        return popFirst();
+    }
+    if (index == m_length - 1) {
+        return pop();
+    }
     Node* temp {get(index)};
     if ( temp != nullptr ) {
         temp -> prev -> next = temp -> next;
@@ -305,31 +521,349 @@ DoublyLinkedList<T>::Node* DoublyLinkedList<T>::remove(int index){
         temp -> next = nullptr;
         --m_length;
     }
-    return temp;
+    return __handle(temp);
 }
 
-template <typename T>
-bool DoublyLinkedList<T>::swapFirstLast(){
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::swapFirstLast(){
     std::cout << "Not implemented\n";
 }
 
-template <typename T>
-bool DoublyLinkedList<T>::reverse(){
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::reverse(){
     std::cout << "Not implemented\n";
 }
 
-template <typename T>
-bool DoublyLinkedList<T>::isPalindrome(){
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::isPalindrome(){
     std::cout << "Not implemented\n";
 }
 
-template <typename T>
-DoublyLinkedList<T>& DoublyLinkedList<T>::operator=(const DoublyLinkedList& source){
+/*  O(n log n)
+ *  Stable bottom-up merge sort. Nodes are taken off the front one at a time
+ *  and carried up through bins, like a binary counter: bin i holds a sorted
+ *  run of 2^i Nodes or nothing, and two runs of the same size are merged into
+ *  the next bin. Nothing is allocated and values are never moved; the merges
+ *  relink next and prev pointers as they go. */
+template <typename T, typename Allocator>
+template <typename Compare>
+void DoublyLinkedList<T, Allocator>::sort(Compare compare){
+    if (m_length < 2) {
+        return;
+    }
+    std::array<Run, s_sortBins> bins {};
+    std::size_t used {0};
+    Node* temp {m_head};
+    while (temp) {
+        Run carry {temp, temp};
+        temp = temp -> next;
+        carry.head -> next = nullptr;
+        carry.head -> prev = nullptr;
+        std::size_t i {0};
+        for (; i < used && bins[i].head; ++i) {
+            // bins hold older Nodes than carry, so they go first for stability
+            carry = __mergeRuns(bins[i], carry, compare);
+            bins[i] = Run{};
+        }
+        if (i == used) {
+            ++used;
+        }
+        bins[i] = carry;
+    }
+    Run sorted {};
+    for (std::size_t i {0}; i < used; ++i) {
+        sorted = __mergeRuns(bins[i], sorted, compare);
+    }
+    m_head = sorted.head;
+    m_tail = sorted.tail;
+}
+
+/*  O(n + m)
+ *  Moves every Node of other, which must be sorted like this list, into its
+ *  sorted place in this list and leaves other empty. Equal values from this
+ *  list stay ahead of those from other. Their allocators must be equal. */
+template <typename T, typename Allocator>
+template <typename Compare>
+void DoublyLinkedList<T, Allocator>::merge(DoublyLinkedList& other, Compare compare){
+    if (this == &other) {
+        return;
+    }
+    Run merged {__mergeRuns(Run{m_head, m_tail}, Run{other.m_head, other.m_tail}, compare)};
+    m_head = merged.head;
+    m_tail = merged.tail;
+    m_length += std::exchange(other.m_length, 0);
+    other.m_head = nullptr;
+    other.m_tail = nullptr;
+}
+
+/*  O(n)
+ *  Deletes every value that equals the value before it, so a sorted list
+ *  keeps one of each. Returns the number of values deleted. */
+template <typename T, typename Allocator>
+template <typename BinaryPredicate>
+int DoublyLinkedList<T, Allocator>::unique(BinaryPredicate equal){
+    int removed {0};
+    Node* temp {m_head};
+    while (temp && temp -> next) {
+        Node* after {temp -> next};
+        if (equal(temp -> value, after -> value)) {
+            temp -> next = after -> next;
+            if (after -> next) {
+                after -> next -> prev = temp;
+            } else {
+                m_tail = temp;
+            }
+            __destroyNode(after);
+            ++removed;
+        } else {
+            temp = after;
+        }
+    }
+    m_length -= removed;
+    return removed;
+}
+
+/*  O(1)
+ *  Uses the tail pointer to move every Node of other onto the end of this
+ *  list, and leaves other empty. Their allocators must be equal. */
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::splice(DoublyLinkedList& other){
+    splice(m_length, other);
+}
+
+/*  O(1) at either end, otherwise O(n)
+ *  Moves every Node of other into this list before the given index, walking
+ *  from whichever end of the list is nearer, and leaves other empty. Their
+ *  allocators must be equal. */
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::splice(int index, DoublyLinkedList& other){
+    if (this == &other || index < 0 || index > m_length) {
+        return false;
+    }
+    if (other.m_length == 0) {
+        return true;
+    }
+    if (m_length == 0) {
+        m_head = other.m_head;
+        m_tail = other.m_tail;
+    } else if (index == m_length) {
+        m_tail -> next = other.m_head;
+        other.m_head -> prev = m_tail;
+        m_tail = other.m_tail;
+    } else {
+        Node* temp {get(index)};
+        other.m_head -> prev = temp -> prev;
+        other.m_tail -> next = temp;
+        if (temp -> prev) {
+            temp -> prev -> next = other.m_head;
+        } else {
+            m_head = other.m_head;
+        }
+        temp -> prev = other.m_tail;
+    }
+    m_length += std::exchange(other.m_length, 0);
+    other.m_head = nullptr;
+    other.m_tail = nullptr;
+    return true;
+}
+
+/*  O(n)
+ *  Counts the links to a Node starting no more than s_nearBytes after the
+ *  end of the Node before it. */
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Locality DoublyLinkedList<T, Allocator>::locality() const {
+    Locality result {};
+    for (Node* temp {m_head}; temp && temp -> next; temp = temp -> next) {
+        ++result.links;
+        auto end {reinterpret_cast<std::uintptr_t>(temp + 1)};
+        auto next {reinterpret_cast<std::uintptr_t>(temp -> next)};
+        if (next >= end && next - end <= s_nearBytes) {
+            ++result.nearLinks;
+        }
+    }
+    return result;
+}
+
+/*  O(n log n), and O(n) extra memory while it runs
+ *  Moves every value into a new Node, laid out in list order, and frees the
+ *  old Nodes, so a walk either way reads memory in order. All the new Nodes
+ *  are allocated before any old one is freed, so they come from fresh
+ *  memory rather than the holes the list left, and are sorted by address
+ *  in case they didn't. The values stay the same, but pointers to the old
+ *  Nodes, and iterators, are left dangling. If memory runs out the list is
+ *  left as it was and nothing is moved. */
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::CompactStats DoublyLinkedList<T, Allocator>::compact(){
+    CompactStats stats {};
+    stats.before = locality();
+    stats.after = stats.before;
+    std::vector<Node*> nodes {};
+    try {
+        nodes.reserve(static_cast<std::size_t>(m_length));
+        for (int i {0}; i < m_length; ++i) {
+            nodes.push_back(NodeTraits::allocate(m_allocator, 1));
+        }
+    } catch (const std::bad_alloc&) {
+        for (Node* node : nodes) {
+            NodeTraits::deallocate(m_allocator, node, 1);
+        }
+        return stats;
+    }
+    if (!std::ranges::is_sorted(nodes)) {
+        std::ranges::sort(nodes);
+    }
+    Node* old {m_head};
+    Node* last {nullptr};
+    for (Node* node : nodes) {
+        NodeTraits::construct(m_allocator, node, std::in_place, std::move(old -> value));
+        node -> prev = last;
+        if (last) {
+            last -> next = node;
+        } else {
+            m_head = node;
+        }
+        last = node;
+        Node* after {old -> next};
+        __destroyNode(old);
+        old = after;
+    }
+    if (last) {
+        m_tail = last;
+    }
+    stats.nodesMoved = nodes.size();
+    stats.bytesMoved = nodes.size() * sizeof(Node);
+    stats.after = locality();
+    return stats;
+}
+
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>& DoublyLinkedList<T, Allocator>::operator=(const DoublyLinkedList& source){
     if (this != &source) {
+        if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+            __clear();
+            m_allocator = source.m_allocator;
+        }
         deepCopy(source);
     }
     return *this;
 }
 
+/*  Move assignment. Takes the source's Nodes and leaves it empty, unless the
+ *  two lists' allocators differ and can't be swapped. Nodes can't change
+ *  allocator, so then the values are moved across one at a time. */
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>& DoublyLinkedList<T, Allocator>::operator=(DoublyLinkedList&& source)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value){
+    if (this == &source) {
+        return *this;
+    }
+    __clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(source.m_allocator);
+    }
+    else if constexpr (!NodeTraits::is_always_equal::value) {
+        if (m_allocator != source.m_allocator) {
+            for (T& value : source) {
+                emplace_back(std::move(value));
+            }
+            source.__clear();
+            return *this;
+        }
+    }
+    m_head = std::exchange(source.m_head, nullptr);
+    m_tail = std::exchange(source.m_tail, nullptr);
+    m_length = std::exchange(source.m_length, 0);
+    return *this;
+}
+
+//  Swaps the Nodes of two lists. Their allocators must be equal or propagate.
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::swap(DoublyLinkedList& other) noexcept{
+    if constexpr (NodeTraits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, other.m_allocator);
+    }
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_length, other.m_length);
+}
+
+/*  Allocates an unlinked Node with the list's allocator and builds its value
+ *  from args in place. A single T argument is copied or moved in.
+ *  Returns nullptr if memory runs out. */
+template <typename T, typename Allocator>
+template <typename... Args>
+DoublyLinkedList<T, Allocator>::Node* DoublyLinkedList<T, Allocator>::__createNode(Args&&... args){
+    Node* node {nullptr};
+    try {
+        node = NodeTraits::allocate(m_allocator, 1);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+    NodeTraits::construct(m_allocator, node, std::in_place, std::forward<Args>(args)...);
+    return node;
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::__destroyNode(Node* node){
+    NodeTraits::destroy(m_allocator, node);
+    NodeTraits::deallocate(m_allocator, node, 1);
+}
+
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::NodeHandle DoublyLinkedList<T, Allocator>::__handle(Node* node){
+    return NodeHandle {node, NodeDeleter{m_allocator}};
+}
+
+// Releases every Node and leaves the list empty.
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::__clear(){
+    Node* temp {m_head};
+    while(m_head) {
+        m_head = m_head->next;
+        __destroyNode(temp);
+        temp = m_head;
+    }
+    m_tail = nullptr;
+    m_length = 0;
+}
+
+/*  Merges two sorted runs into one by relinking their Nodes, setting prev
+ *  pointers as it goes. Ties go to left, which keeps the merge stable when
+ *  left holds the earlier Nodes. The new tail is the tail of whichever run
+ *  was left over. The next Node is picked with selects rather than a branch,
+ *  which random keys would mispredict. */
+template <typename T, typename Allocator>
+template <typename Compare>
+DoublyLinkedList<T, Allocator>::Run DoublyLinkedList<T, Allocator>::__mergeRuns(Run left, Run right, Compare& compare){
+    if (!left.head) {
+        return right;
+    }
+    if (!right.head) {
+        return left;
+    }
+    Node* head {nullptr};
+    Node* last {nullptr};
+    Node* first {left.head};
+    Node* second {right.head};
+    while (first && second) {
+        bool takeSecond {static_cast<bool>(compare(second -> value, first -> value))};
+        Node* taken {takeSecond ? second : first};
+        Node* after {taken -> next};
+        first = takeSecond ? first : after;
+        second = takeSecond ? after : second;
+        taken -> prev = last;
+        if (last) {
+            last -> next = taken;
+        } else {
+            head = taken;
+        }
+        last = taken;
+    }
+    Node* rest {first ? first : second};
+    last -> next = rest;
+    rest -> prev = last;
+    return Run{head, first ? left.tail : right.tail};
+}
+
 }
 #endif
@@ -0,0 +1,378 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+/* Sam Drew ~ 2025
+ * Intrusive Doubly Linked List implementation in C++
+ * ---
+ *  This is a simple implementation of an intrusive Doubly Linked List.
+ *  Written by me, for my own edification in data structures and algorithms
+ *  and C++.
+ *
+ *  WARNING: Do not use this library in projects. Instead use an established
+ *  intrusive container such as boost::intrusive::list.
+ *
+ *  Unlike sjd::DoublyLinkedList, this list doesn't own its values or make
+ *  Nodes for them. The links live in a hook inside the objects themselves,
+ *  so objects that already live somewhere else (in a pool, an array or on
+ *  the stack) can be put on a list and taken off it again without a single
+ *  allocation or copy.
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace sjd {
+
+/* Intrusive List Hook template struct.
+ *  The links an object needs to sit on one IntrusiveList. Give an object a
+ *  hook for each list it should be able to sit on at the same time.
+ *  A hook that is on a list always has a prev link; the head's prev is the
+ *  list's tail. So a hook knows whether it is linked without knowing which
+ *  list it is on.
+ */
+template <typename T>
+struct IntrusiveListHook {
+    T* next {nullptr};
+    T* prev {nullptr};
+
+    IntrusiveListHook() = default;
+    ~IntrusiveListHook() = default;
+
+    // A copy of an object starts off on no list, whatever lists the source
+    // object is on, and assigning to an object leaves its lists alone.
+    IntrusiveListHook(const IntrusiveListHook&) noexcept {}
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept { return *this; }
+
+    bool isLinked() const { return prev != nullptr; }
+};
+
+/* Intrusive List template class.
+ *  Links objects of type T through their Hook member. The list only points
+ *  at the objects: they must outlive their time on the list, and must be
+ *  taken off it before they are destroyed. Destroying or clearing the list
+ *  unlinks every object still on it.
+ *  Member function implementations can be found below the class declaration.
+ *  Example:
+ *      struct Job {
+ *          int id {};
+ *          sjd::IntrusiveListHook<Job> queued {};
+ *          sjd::IntrusiveListHook<Job> owned {};
+ *      };
+ *      std::array<Job, 3> jobs {Job{1}, Job{2}, Job{3}};
+ *      sjd::IntrusiveList<Job, &Job::queued> queue {};
+ *      sjd::IntrusiveList<Job, &Job::owned> mine {};
+ *      queue.append(jobs[0]);              // queue: [1]
+ *      queue.append(jobs[2]);              // queue: [1, 3]
+ *      mine.append(jobs[2]);               // mine: [3], still on queue
+ *      queue.remove(jobs[2]);              // queue: [1], O(1)
+ *
+ *  Linking and unlinking are O(1) and never allocate. append(), prepend()
+ *  and insertBefore() refuse an object whose hook is already linked, and
+ *  remove() refuses one whose hook isn't. An object must only be removed
+ *  from, or inserted next to, the list it is on.
+ *  begin() and end() give bidirectional iterators over the objects.
+ *
+ *  NOTE: A Class like this is already implemented in the boost library as
+ *  boost::intrusive::list. Prefer to use the established container for all
+ *  collaborative work.
+ */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+class IntrusiveList {
+public:
+
+    /* Bidirectional iterator over the objects in the list. Const iterators
+     * give read-only access to the objects; iterators convert to them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        Iterator(T* object, const IntrusiveList* list) : m_object {object}, m_list {list} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_object, m_list}; }
+
+        reference operator*() const { return *m_object; }
+        pointer operator->() const { return m_object; }
+
+        Iterator& operator++() {
+            m_object = (m_object ->* Hook).next;
+            return *this;
+        }
+
+        // Stepping back from end() lands on the tail.
+        Iterator& operator--() {
+            m_object = m_object ? (m_object ->* Hook).prev : m_list -> tail();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        Iterator operator--(int) {
+            Iterator old {*this};
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_object == other.m_object; }
+
+    private:
+        T* m_object {nullptr};                      // nullptr at end()
+        const IntrusiveList* m_list {nullptr};      // lets end() step back
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // accessors
+    T* head() const { return m_head; }
+    T* tail() const { return m_head ? (m_head ->* Hook).prev : nullptr; }
+    iterator begin() { return {m_head, this}; }
+    iterator end() { return {nullptr, this}; }
+    const_iterator begin() const { return {m_head, this}; }
+    const_iterator end() const { return {nullptr, this}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+    int length() const { return m_length; }
+
+    // constructor and destructor
+    IntrusiveList() = default;
+    ~IntrusiveList();
+
+    // An object's hook can only be on one list, so lists can't be copied.
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    // Move constructor. Takes the source's objects and leaves it empty.
+    IntrusiveList(IntrusiveList&& source) noexcept
+    : m_head {std::exchange(source.m_head, nullptr)}
+    , m_length {std::exchange(source.m_length, 0)}
+    {
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& source) noexcept;
+
+    void swap(IntrusiveList& other) noexcept;
+    friend void swap(IntrusiveList& a, IntrusiveList& b) noexcept { a.swap(b); }
+
+    void printList() const;
+
+    bool append(T& object);
+
+    bool prepend(T& object);
+
+    bool insertBefore(T& position, T& object);
+
+    bool remove(T& object);
+
+    T* pop();
+
+    T* popFirst();
+
+    void splice(IntrusiveList& other);
+
+    void clear();
+
+private:
+
+    T* m_head {nullptr};
+    int m_length {};
+
+    static IntrusiveListHook<T>& __hook(T& object) { return object.*Hook; }
+
+};
+
+template <typename T, IntrusiveListHook<T> T::* Hook>
+IntrusiveList<T, Hook>::~IntrusiveList() {
+    clear();
+}
+
+/*  O(n)
+ *  Unlinks the objects already on this list, then takes the source's. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+IntrusiveList<T, Hook>& IntrusiveList<T, Hook>::operator=(IntrusiveList&& source) noexcept {
+    if (this != &source) {
+        clear();
+        swap(source);
+    }
+    return *this;
+}
+
+template <typename T, IntrusiveListHook<T> T::* Hook>
+void IntrusiveList<T, Hook>::swap(IntrusiveList& other) noexcept {
+    std::swap(m_head, other.m_head);
+    std::swap(m_length, other.m_length);
+}
+
+template <typename T, IntrusiveListHook<T> T::* Hook>
+void IntrusiveList<T, Hook>::printList() const {
+    for (const T& object : *this) {
+        std::cout << object << "\n";
+    }
+}
+
+/*  O(1)
+ *  Links the object on after the tail, which the head's prev points at. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+bool IntrusiveList<T, Hook>::append(T& object) {
+    IntrusiveListHook<T>& hook {__hook(object)};
+    if (hook.isLinked()) {
+        return false;
+    }
+    hook.next = nullptr;
+    if (!m_head) {
+        hook.prev = &object;
+        m_head = &object;
+    } else {
+        T* last {tail()};
+        __hook(*last).next = &object;
+        hook.prev = last;
+        __hook(*m_head).prev = &object;
+    }
+    ++m_length;
+    return true;
+}
+
+/*  O(1)
+ *  Links the object on in front of the head. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+bool IntrusiveList<T, Hook>::prepend(T& object) {
+    if (!m_head) {
+        return append(object);
+    }
+    IntrusiveListHook<T>& hook {__hook(object)};
+    if (hook.isLinked()) {
+        return false;
+    }
+    hook.next = m_head;
+    hook.prev = tail();
+    __hook(*m_head).prev = &object;
+    m_head = &object;
+    ++m_length;
+    return true;
+}
+
+/*  O(1)
+ *  Links the object on just before position, which must be on this list. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+bool IntrusiveList<T, Hook>::insertBefore(T& position, T& object) {
+    IntrusiveListHook<T>& hook {__hook(object)};
+    IntrusiveListHook<T>& after {__hook(position)};
+    if (hook.isLinked() || !after.isLinked()) {
+        return false;
+    }
+    if (&position == m_head) {
+        return prepend(object);
+    }
+    T* before {after.prev};
+    __hook(*before).next = &object;
+    hook.prev = before;
+    hook.next = &position;
+    after.prev = &object;
+    ++m_length;
+    return true;
+}
+
+/*  O(1)
+ *  Unlinks the object, which must be on this list, without looking for it. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+bool IntrusiveList<T, Hook>::remove(T& object) {
+    IntrusiveListHook<T>& hook {__hook(object)};
+    if (!hook.isLinked()) {
+        return false;
+    }
+    if (&object == m_head) {
+        m_head = hook.next;
+        if (m_head) {
+            __hook(*m_head).prev = hook.prev;
+        }
+    } else {
+        __hook(*hook.prev).next = hook.next;
+        if (hook.next) {
+            __hook(*hook.next).prev = hook.prev;
+        } else {
+            __hook(*m_head).prev = hook.prev;   // object was the tail
+        }
+    }
+    hook.next = nullptr;
+    hook.prev = nullptr;
+    --m_length;
+    return true;
+}
+
+/*  O(1)
+ *  Unlinks the tail and returns it, or nullptr if the list is empty. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+T* IntrusiveList<T, Hook>::pop() {
+    T* last {tail()};
+    if (last) {
+        remove(*last);
+    }
+    return last;
+}
+
+/*  O(1)
+ *  Unlinks the head and returns it, or nullptr if the list is empty. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+T* IntrusiveList<T, Hook>::popFirst() {
+    T* first {m_head};
+    if (first) {
+        remove(*first);
+    }
+    return first;
+}
+
+/*  O(1)
+ *  Moves every object on other onto the end of this list and leaves other
+ *  empty. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+void IntrusiveList<T, Hook>::splice(IntrusiveList& other) {
+    if (this == &other || !other.m_head) {
+        return;
+    }
+    if (!m_head) {
+        swap(other);
+        return;
+    }
+    T* last {tail()};
+    T* otherLast {other.tail()};
+    __hook(*last).next = other.m_head;
+    __hook(*other.m_head).prev = last;
+    __hook(*m_head).prev = otherLast;
+    m_length += std::exchange(other.m_length, 0);
+    other.m_head = nullptr;
+}
+
+/*  O(n)
+ *  Unlinks every object, so each can go on a list again. */
+template <typename T, IntrusiveListHook<T> T::* Hook>
+void IntrusiveList<T, Hook>::clear() {
+    T* temp {m_head};
+    while (temp) {
+        IntrusiveListHook<T>& hook {__hook(*temp)};
+        temp = hook.next;
+        hook.next = nullptr;
+        hook.prev = nullptr;
+    }
+    m_head = nullptr;
+    m_length = 0;
+}
+
+} // end namespace sjd
+#endif
@@ -15,7 +15,18 @@
  *  newer.
  */
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /* Linked List template class.
  *  
@@ -28,13 +39,32 @@
  *      myList.append(4);               // myList: [3, 4]
  *      myList.prepend(2);              // myList: [2, 3, 4]
  *      myList.set(0, 1);               // myList: [1, 3, 4]
+ *      for (int& value : myList) {}    // visits 1, 3 and 4
+ *
+ *  Values passed as rvalues are moved into their Nodes, and the emplace
+ *  functions build a value straight into its Node from the arguments for
+ *  its constructor, so large values are never copied on the way in. Moving
+ *  or swapping a whole List just hands its Nodes over.
+ *  sort(), merge(), unique() and splice() only relink the Nodes already in
+ *  the Lists, so they never allocate and never copy or move a value.
+ *  get(), and so set(), insert() and deleteNode(), walk on from the last
+ *  Node found rather than from the head where they can, and an optional
+ *  skip index cuts any positional lookup down to a short walk. get() on a
+ *  const List only reads, so several threads may call it at once.
+ *  After a lot of inserts and deletes the Nodes end up all over the heap;
+ *  compact() moves them into fresh memory in list order so scans run fast.
+ *  begin() and end() give forward iterators over the values, with end()
+ *  one past the last; head() and tail() give the first and last Nodes.
+ *  Nodes are allocated with Allocator, rebound to Node. std::allocator is
+ *  the default; sjd::PoolAllocator (node_pool.h) serves them from a
+ *  per-thread pool, for containers that stay on one thread.
  *
  *  NOTE: This is already implemented in the standard C++ library as the 
  *  std::forward_list container. Prefer to use the standard container for all 
  *  collaborative work. 
  */
 namespace sjd {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class LinkedList {
 public:
 
@@ -44,36 +74,165 @@ public:
         T value     {};             // some object of any type
         Node* next  {nullptr};      // null pointer which will point to the next node
 
+        // Builds the value straight from args, whatever T's constructors are.
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+        // Nodes stay where they were allocated and are never copied.
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
+
     };
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    /* Forward iterator over the values in the List. Const iterators give
+     * read-only access to the values; iterators convert to them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        explicit Iterator(Node* node) : m_node {node} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_node}; }
+
+        reference operator*() const { return m_node -> value; }
+        pointer operator->() const { return &(m_node -> value); }
+
+        Iterator& operator++() {
+            m_node = m_node -> next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_node == other.m_node; }
+
+        Node* node() const { return m_node; }
+
+    private:
+        Node* m_node {nullptr};     // nullptr at end()
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
     // accessors
-    Node* begin() const { return m_head; }
-    Node* end() const { return m_tail; }
+    Node* head() const { return m_head; }
+    Node* tail() const { return m_tail; }
+    iterator begin() { return iterator{m_head}; }
+    iterator end() { return iterator{}; }
+    const_iterator begin() const { return const_iterator{m_head}; }
+    const_iterator end() const { return const_iterator{}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
     int length() const { return m_length; }
+    Allocator get_allocator() const { return Allocator(m_allocator); }
 
     // constructors & destructor
-    explicit LinkedList(const T& value);
+    explicit LinkedList(const T& value, const Allocator& allocator = Allocator{});
+    explicit LinkedList(T&& value, const Allocator& allocator = Allocator{});
     ~LinkedList();
 
     // Copy constructor
     void deepCopy(const LinkedList& source);
-    LinkedList(const LinkedList& source) { deepCopy(source); }
+    LinkedList(const LinkedList& source)
+    : m_allocator {NodeTraits::select_on_container_copy_construction(source.m_allocator)}
+    {
+        deepCopy(source);
+    }
+
+    // Move constructor. Takes the source's Nodes, and its skip index if it
+    // has one, and leaves it empty.
+    LinkedList(LinkedList&& source) noexcept
+    : m_allocator {std::move(source.m_allocator)}
+    , m_head {std::exchange(source.m_head, nullptr)}
+    , m_tail {std::exchange(source.m_tail, nullptr)}
+    , m_length {std::exchange(source.m_length, 0)}
+    , m_cursor {std::exchange(source.m_cursor, nullptr)}
+    , m_cursorIndex {std::exchange(source.m_cursorIndex, 0)}
+    , m_skip {std::move(source.m_skip)}
+    {
+    }
 
     void printList() const;
 
-    bool append(const T& value);
+    bool append(const T& value) { return emplace_back(value); }
+    bool append(T&& value) { return emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    bool emplace_back(Args&&... args);
 
     void deleteLast();
 
     void deleteFirst();
 
-    void prepend(const T& value);
+    void prepend(const T& value) { emplace_front(value); }
+    void prepend(T&& value) { emplace_front(std::move(value)); }
+
+    template <typename... Args>
+    bool emplace_front(Args&&... args);
+
+    /* Positional access. get() remembers the Node it found last, so a
+     * lookup at or after that index walks on from there rather than from
+     * the head, and a loop over rising indexes, such as set(i, ...) for
+     * every i, costs O(n) in all rather than O(n^2). The last index goes
+     * straight to the tail. Only this non-const get() moves the cursor,
+     * counts stats and rebuilds a stale skip index.
+     *
+     *  get() on a const List is a pure read: it walks from the head, or from
+     *  the skip index if that is up to date, and changes nothing. Any number
+     *  of threads may read a List through const lookups at once as long as
+     *  none of them changes it; every non-const call, get() included, needs
+     *  the List to itself.
+     *
+     *  enableSkipIndex also keeps a pointer to about every stride'th Node.
+     *  A lookup binary searches them for the nearest one at or before the
+     *  index, then walks fewer than 2 * stride Nodes: O(log n + stride).
+     *  Appends and deletes at the ends keep it up to date in O(1) time;
+     *  inserts and deletes elsewhere in O(n / stride) time. sort(),
+     *  reverse() and the like leave it to be rebuilt on the next lookup.
+     *  indexStats reports how far lookups walked and how many hops the
+     *  cursor and the skip index saved over walking from the head.
+     */
+    Node* get(int index);
+
+    const Node* get(int index) const;
 
-    Node* get(int index) const;
+    void enableSkipIndex(int stride = 32);
+
+    void disableSkipIndex() { m_skip.reset(); }
+
+    struct IndexStats {
+        std::size_t lookups {0};        // calls to get(), including those from set() etc.
+        std::size_t cursorStarts {0};   // walked on from the last Node found
+        std::size_t indexStarts {0};    // started from a skip index checkpoint
+        std::size_t hops {0};           // next pointers followed
+        std::size_t hopsSaved {0};      // hops a walk from the head would have added
+        std::size_t checkpoints {0};    // Nodes the skip index points at
+    };
+
+    IndexStats indexStats() const;
+
+    void resetIndexStats() { m_stats = IndexStats{}; }
 
     bool set(int index, const T& value);
 
-    bool insert(int index, const T& value);
+    bool insert(int index, const T& value) { return emplace(index, value); }
+    bool insert(int index, T&& value) { return emplace(index, std::move(value)); }
+
+    template <typename... Args>
+    bool emplace(int index, Args&&... args);
 
     void deleteNode(int index);
 
@@ -81,13 +240,95 @@ public:
 
     Node* middle();
 
+    template <typename Compare = std::less<>>
+    void sort(Compare compare = Compare{});
+
+    template <typename Compare = std::less<>>
+    void merge(LinkedList& other, Compare compare = Compare{});
+
+    template <typename BinaryPredicate = std::equal_to<>>
+    int unique(BinaryPredicate equal = BinaryPredicate{});
+
+    void splice(LinkedList& other);
+
+    bool splice(int index, LinkedList& other);
+
+    /* How well the Nodes are laid out for a walk down the List. A link is
+     * near when the next Node starts at most s_nearBytes past the end of
+     * the Node before it, close enough for the hardware prefetcher to have
+     * it ready. Freshly appended Nodes mostly are; after a lot of inserts
+     * and deletes most links jump somewhere else on the heap.
+     */
+    struct Locality {
+        std::size_t links {0};      // next pointers between Nodes
+        std::size_t nearLinks {0};  // links to a Node just after this one
+    };
+
+    Locality locality() const;
+
+    struct CompactStats {
+        std::size_t nodesMoved {0};
+        std::size_t bytesMoved {0};     // nodesMoved * sizeof(Node)
+        Locality before {};
+        Locality after {};
+    };
+
+    CompactStats compact();
+
     LinkedList& operator=(const LinkedList& source);
 
+    LinkedList& operator=(LinkedList&& source)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value);
+
+    void swap(LinkedList& other) noexcept;
+    friend void swap(LinkedList& a, LinkedList& b) noexcept { a.swap(b); }
+
 private:
 
+    [[no_unique_address]] NodeAllocator m_allocator {};
     Node* m_head {nullptr};     // pointer to the first Node in the Linked List.
     Node* m_tail {nullptr};     // pointer to the last Node in the Linked List.
     int m_length {};            // The length of the Linked List.
+    Node* m_cursor {nullptr};   // the Node get() found last, or nullptr
+    int m_cursorIndex {0};      // the index of m_cursor
+
+    // A Node that lookups can start from, and its index. Checkpoints are
+    // kept in index order, no more than 2 * stride Nodes apart.
+    struct Checkpoint {
+        Node* node {nullptr};
+        int index {0};
+    };
+    struct SkipIndex {
+        int stride {};
+        bool stale {false};             // rebuilt from scratch on next lookup
+        std::vector<Checkpoint> checkpoints {};
+    };
+    std::unique_ptr<SkipIndex> m_skip {};   // nullptr unless enabled
+    IndexStats m_stats {};
+
+    // A sorted chain of Nodes ending in nullptr, with its last Node.
+    struct Run {
+        Node* head {nullptr};
+        Node* tail {nullptr};
+    };
+
+    // One run of 2^i Nodes per bin is enough for any int length.
+    static constexpr std::size_t s_sortBins {64};
+
+    // How far past a Node the next one can start and still count as near.
+    static constexpr std::uintptr_t s_nearBytes {256};
+
+    template <typename... Args>
+    Node* __createNode(Args&&... args);
+    void __destroyNode(Node* node);
+    void __clear();
+    template <typename Compare>
+    static Run __mergeRuns(Run left, Run right, Compare& compare);
+    void __forgetPositions();
+    void __rebuildSkipIndex();
+    void __fillSkipGap(std::size_t position);
+    void __skipInserted(int index);
+    void __skipErased(const Node* node, int index);
 
 };
 
@@ -96,9 +337,19 @@ private:
 //---
 /*  Implementation of member functions included as most are templated. The 
  *  compiler therefore requires the full definition included.*/
-template <typename T>
-LinkedList<T>::LinkedList(const T& value)
-    : m_head    {new Node{value}}
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(const T& value, const Allocator& allocator)
+    : m_allocator {allocator}
+    , m_head    {__createNode(value)}
+    , m_tail    {m_head}
+    , m_length  {1}
+{
+}
+
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(T&& value, const Allocator& allocator)
+    : m_allocator {allocator}
+    , m_head    {__createNode(std::move(value))}
     , m_tail    {m_head}
     , m_length  {1}
 {
@@ -107,48 +358,44 @@ LinkedList<T>::LinkedList(const T& value)
 /* Destructor method. Iterates along the list, releasing each Node from memory.
  * O(n). This method iterates through each member of of the list making it O(n) 
  * where n = the number of Nodes in the list.*/
-template <typename T>
-LinkedList<T>::~LinkedList(){
-    Node* temp {m_head};
-    while(m_head){
-        m_head = m_head->next;
-        delete temp;
-        temp = m_head;
-    }
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::~LinkedList(){
+    __clear();
 }
 
-template <typename T>
-void LinkedList<T>::deepCopy(const LinkedList& source){
+/* Replaces the contents of this List with copies of the source's values.
+ * O(n + m). Every Node already in this List is released first, then one Node
+ * is made for each of the m values in the source.
+ */
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::deepCopy(const LinkedList& source){
 
-    delete m_head;
-    delete m_tail;
+    __clear();
 
     m_length = source.m_length;
 
     if (source.m_head) {
 
-        m_head = new Node{source.m_head -> value};
+        m_head = __createNode(source.m_head -> value);
         m_tail = m_head;
         Node* sourceTemp {source.m_head -> next};
 
         while (sourceTemp) {
-            m_tail -> next = new Node {sourceTemp -> value};
+            m_tail -> next = __createNode(sourceTemp -> value);
             sourceTemp = sourceTemp -> next;
             m_tail = m_tail -> next;
         }
     }
-    else {
-        m_head = nullptr;
-        m_tail = nullptr;
-    }
+    if (source.m_skip) enableSkipIndex(source.m_skip -> stride);
+    else disableSkipIndex();
 }
 
 
 /* prints the linked list items. One item per line.
  * O(n). This method iterates through each member of of the list making it O(n) 
  * where n = the number of Nodes in the list. */
-template <typename T>
-void LinkedList<T>::printList() const {
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::printList() const {
     Node* temp {m_head};
     while(temp) {
         std::cout << temp->value << "\n";
@@ -156,14 +403,15 @@ void LinkedList<T>::printList() const {
     }
 }
 
-/* Adds the given value to the end of the List in a Node.
+/* Adds a value built from args to the end of the List in a Node.
  * O(1). This method will use the tail pointer to alter the last Node in the
  * List. No iteration is needed so complexity is constant, regardless of the 
  * length of the List.
  */
-template <typename T>
-bool LinkedList<T>::append(const T& value) {
-    Node* newNode = new Node {value};
+template <typename T, typename Allocator>
+template <typename... Args>
+bool LinkedList<T, Allocator>::emplace_back(Args&&... args) {
+    Node* newNode = __createNode(std::forward<Args>(args)...);
     if (m_length == 0){
         m_head = newNode;
         m_tail = newNode;
@@ -173,31 +421,31 @@ bool LinkedList<T>::append(const T& value) {
         m_tail = newNode;
     }
     ++m_length;
+    __skipInserted(m_length - 1);
     return(true);
 }
 
 /* Deletes the last Node in the List.
- * O(n). This method must iterate through each member of the list to find 
- * the 2nd-to-last item. Making it O(n) where n = the number of Nodes in the 
- * list. 
+ * O(n). This method must find the 2nd-to-last item with get(), which walks
+ * from the head unless the cursor or the skip index is nearer. Making it O(n)
+ * where n = the number of Nodes in the list.
  */
-template <typename T>
-void LinkedList<T>::deleteLast(){
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::deleteLast(){
     if (m_length == 0 ) return;
     Node* temp {m_head};
     if (m_length == 1 ) {
         m_head = nullptr;
         m_tail = nullptr;
+        m_cursor = nullptr;
     } else {
-        while(temp->next != m_tail){
-            temp = temp->next;
-        }
-        m_tail = temp;
+        m_tail = get(m_length - 2);
         temp = m_tail->next;
         m_tail->next = nullptr;
     }
-    delete temp;
     --m_length;
+    __skipErased(temp, m_length);
+    __destroyNode(temp);
 }
 
 /* Removes the first value from the front of the List.
@@ -205,8 +453,8 @@ void LinkedList<T>::deleteLast(){
  * List. No iteration is needed so complexity is constant, regardless of the 
  * length of the List.
  */
-template <typename T>
-void LinkedList<T>::deleteFirst(){
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::deleteFirst(){
     if (m_length == 0 ) return;
     Node* temp {m_head};
     if (m_length == 1 ) {
@@ -215,46 +463,131 @@ void LinkedList<T>::deleteFirst(){
     } else {
         m_head = m_head->next;
     }
-    delete temp;
+    if (m_cursor == temp) m_cursor = nullptr;
+    else --m_cursorIndex;
     --m_length;
+    __skipErased(temp, 0);
+    __destroyNode(temp);
 }
 
-/* Adds the given value to the front of the List.
+/* Adds a value built from args to the front of the List.
  * O(1). This method will use the head pointer to alter the first Node in the
  * List. No iteration is needed so complexity is constant, regardless of the 
  * length of the List. 
  */
-template <typename T>
-void LinkedList<T>::prepend(const T& value){
-    Node* newNode = new Node {value};
+template <typename T, typename Allocator>
+template <typename... Args>
+bool LinkedList<T, Allocator>::emplace_front(Args&&... args){
+    Node* newNode = __createNode(std::forward<Args>(args)...);
     newNode->next = m_head;
     m_head = newNode;
     if (m_length == 0) m_tail = newNode;
     ++m_length;
+    ++m_cursorIndex;
+    __skipInserted(0);
+    return true;
 }
 
 /* Returns the Node at the position given.
  * O(n). Iterates through the list until it reaches the index of the requested
- * Node making it O(n) where n = index.
+ * Node, starting from whichever of the head, the cursor and the nearest skip
+ * index checkpoint is closest before it. Making it O(n) where n = the
+ * distance walked; O(1) when walking on from the cursor to the next index.
  */
-template <typename T>
-LinkedList<T>::Node* LinkedList<T>::get(int index) const {
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::get(int index) {
     if (index < 0 || index >= m_length) {
         return nullptr;
     }
+    ++m_stats.lookups;
     Node* temp {m_head};
-    for (int i {0}; i < index; i++){
+    int at {0};
+    if (index == m_length - 1) {
+        temp = m_tail;
+        at = index;
+    }
+    else {
+        if (m_cursor && m_cursorIndex <= index) {
+            temp = m_cursor;
+            at = m_cursorIndex;
+        }
+        bool fromIndex {false};
+        if (m_skip) {
+            if (m_skip -> stale) __rebuildSkipIndex();
+            const auto& checkpoints {m_skip -> checkpoints};
+            auto after {std::ranges::upper_bound(checkpoints, index, {}, &Checkpoint::index)};
+            if (after != checkpoints.begin() && std::prev(after) -> index > at) {
+                temp = std::prev(after) -> node;
+                at = std::prev(after) -> index;
+                fromIndex = true;
+            }
+        }
+        if (fromIndex) ++m_stats.indexStarts;
+        else if (at > 0) ++m_stats.cursorStarts;
+    }
+    m_stats.hops += static_cast<std::size_t>(index - at);
+    m_stats.hopsSaved += static_cast<std::size_t>(at);
+    for (; at < index; ++at){
+        temp = temp->next;
+    }
+    m_cursor = temp;
+    m_cursorIndex = index;
+    return temp;
+}
+
+/* Returns the Node at the position given without moving the cursor or
+ * counting stats, so const Lists can be read from several threads at once.
+ * O(n). Walks from the head, or from the nearest checkpoint before the index
+ * when the skip index is up to date.
+ */
+template <typename T, typename Allocator>
+const LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::get(int index) const {
+    if (index < 0 || index >= m_length) {
+        return nullptr;
+    }
+    if (index == m_length - 1) {
+        return m_tail;
+    }
+    const Node* temp {m_head};
+    int at {0};
+    if (m_skip && !(m_skip -> stale)) {
+        const auto& checkpoints {m_skip -> checkpoints};
+        auto after {std::ranges::upper_bound(checkpoints, index, {}, &Checkpoint::index)};
+        if (after != checkpoints.begin()) {
+            temp = std::prev(after) -> node;
+            at = std::prev(after) -> index;
+        }
+    }
+    for (; at < index; ++at){
         temp = temp->next;
     }
     return temp;
 }
 
+/* Keeps a pointer to every stride'th Node so get() can start near the index
+ * it wants. Replaces any skip index already enabled.
+ * O(n). Builds the checkpoints with a single walk down the List.
+ */
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::enableSkipIndex(int stride){
+    m_skip = std::make_unique<SkipIndex>();
+    m_skip -> stride = std::max(stride, 1);
+    __rebuildSkipIndex();
+}
+
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::IndexStats LinkedList<T, Allocator>::indexStats() const {
+    IndexStats stats {m_stats};
+    stats.checkpoints = m_skip ? m_skip -> checkpoints.size() : 0;
+    return stats;
+}
+
 /* Change the value of the Node at the given index.
  * O(n). Iterates through the list until it reaches the index of the requested
  * Node making it O(n) where n = index.
  */
-template <typename T>
-bool LinkedList<T>::set(int index, const T& value){
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::set(int index, const T& value){
     Node* temp = get(index);
     if (temp) {
         temp->value = value;
@@ -263,28 +596,28 @@ bool LinkedList<T>::set(int index, const T& value){
     return false;
 }
 
-/* inserts the given value in a Node before the given index in the List
+/* inserts a value built from args in a Node before the given index in the List
  * O(n). Iterates through the list until it reaches the index of the requested
  * Node making it O(n) where n = index.
  */
-template <typename T>
-bool LinkedList<T>::insert(int index, const T& value){
+template <typename T, typename Allocator>
+template <typename... Args>
+bool LinkedList<T, Allocator>::emplace(int index, Args&&... args){
     if (index < 0 || index > m_length) return false;
     if (index == 0) {
-        prepend(value);
-        return true;
+        return emplace_front(std::forward<Args>(args)...);
     }
     if (index == m_length) {
-        append(value);
-        return true;
+        return emplace_back(std::forward<Args>(args)...);
     }
 
-    Node* newNode = new Node {value};
+    Node* newNode = __createNode(std::forward<Args>(args)...);
     Node* temp {get(index-1)};
 
     newNode->next = temp->next;
     temp->next = newNode;
     ++m_length;
+    __skipInserted(index);
     return true;
 }
 
@@ -292,26 +625,27 @@ bool LinkedList<T>::insert(int index, const T& value){
  * O(n). Iterates through the list until it reaches the index of the requested
  * Node making it O(n) where n = index.
  */
-template <typename T>
-void LinkedList<T>::deleteNode(int index){
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::deleteNode(int index){
     if ( index < 0 || index >= m_length ) return;
-    if ( index == 0 ) deleteFirst();
-    if ( index == m_length-1 ) deleteLast();
+    if ( index == 0 ) return deleteFirst();
+    if ( index == m_length-1 ) return deleteLast();
 
     Node* prev {get(index-1)};
     Node* temp {prev->next};
 
     prev->next = temp->next;
-    delete temp;
-    ++m_length;
+    --m_length;
+    __skipErased(temp, index);
+    __destroyNode(temp);
 }
 
 /* flips the List around so that head is tail and tail is head.
  * O(n). The List must be iterated down so the complexity is O(n) where 
  * n = length of the List.
  */
-template <typename T>
-void LinkedList<T>::reverse() {
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::reverse() {
     Node* temp {m_head};
     Node* after {m_head};
     Node* before {nullptr};
@@ -323,11 +657,12 @@ void LinkedList<T>::reverse() {
     }
     m_tail = m_head;
     m_head = before;
+    __forgetPositions();
 }
 
 // Finds and returns the middle Node in the List.
-template <typename T>
-LinkedList<T>::Node* LinkedList<T>::middle() {
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::middle() {
     Node* tortoise {m_head};
     Node* hare {m_head};
     while (hare && hare->next) {
@@ -337,13 +672,369 @@ LinkedList<T>::Node* LinkedList<T>::middle() {
     return tortoise;
 }
 
-template <typename T>
-LinkedList<T>& LinkedList<T>::operator=(const LinkedList& source){
+/* Sorts the List with a stable bottom-up merge sort.
+ * O(n log n). Nodes are taken off the front one at a time and carried up
+ * through bins, like a binary counter: bin i holds a sorted run of 2^i Nodes
+ * or nothing, and two runs of the same size are merged into the next bin.
+ * Runs are merged while they are still warm in cache, nothing is allocated
+ * and values are never moved; only next pointers change.
+ */
+template <typename T, typename Allocator>
+template <typename Compare>
+void LinkedList<T, Allocator>::sort(Compare compare){
+    if (m_length < 2) return;
+    std::array<Run, s_sortBins> bins {};
+    std::size_t used {0};
+    Node* temp {m_head};
+    while (temp) {
+        Run carry {temp, temp};
+        temp = temp -> next;
+        carry.head -> next = nullptr;
+        std::size_t i {0};
+        for (; i < used && bins[i].head; ++i) {
+            // bins hold older Nodes than carry, so they go first for stability
+            carry = __mergeRuns(bins[i], carry, compare);
+            bins[i] = Run{};
+        }
+        if (i == used) ++used;
+        bins[i] = carry;
+    }
+    Run sorted {};
+    for (std::size_t i {0}; i < used; ++i) {
+        sorted = __mergeRuns(bins[i], sorted, compare);
+    }
+    m_head = sorted.head;
+    m_tail = sorted.tail;
+    __forgetPositions();
+}
+
+/* Moves every Node of other, which must be sorted like this List, into its
+ * sorted place in this List and leaves other empty. Equal values from this
+ * List stay ahead of those from other. Their allocators must be equal.
+ * O(n + m). Only next pointers change.
+ */
+template <typename T, typename Allocator>
+template <typename Compare>
+void LinkedList<T, Allocator>::merge(LinkedList& other, Compare compare){
+    if (this == &other) return;
+    Run merged {__mergeRuns(Run{m_head, m_tail}, Run{other.m_head, other.m_tail}, compare)};
+    m_head = merged.head;
+    m_tail = merged.tail;
+    m_length += std::exchange(other.m_length, 0);
+    other.m_head = nullptr;
+    other.m_tail = nullptr;
+    __forgetPositions();
+    other.__forgetPositions();
+}
+
+/* Deletes every value that equals the value before it, so a sorted List
+ * keeps one of each. Returns the number of values deleted.
+ * O(n).
+ */
+template <typename T, typename Allocator>
+template <typename BinaryPredicate>
+int LinkedList<T, Allocator>::unique(BinaryPredicate equal){
+    int removed {0};
+    Node* temp {m_head};
+    while (temp && temp -> next) {
+        Node* after {temp -> next};
+        if (equal(temp -> value, after -> value)) {
+            temp -> next = after -> next;
+            if (after == m_tail) m_tail = temp;
+            __destroyNode(after);
+            ++removed;
+        } else {
+            temp = after;
+        }
+    }
+    m_length -= removed;
+    if (removed > 0) __forgetPositions();
+    return removed;
+}
+
+/* Moves every Node of other onto the end of this List and leaves other
+ * empty. Their allocators must be equal.
+ * O(1). Uses the tail pointer, so nothing is walked.
+ */
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::splice(LinkedList& other){
+    splice(m_length, other);
+}
+
+/* Moves every Node of other into this List before the given index and leaves
+ * other empty. Their allocators must be equal.
+ * O(1) at either end of the List, otherwise O(n) where n = index.
+ */
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::splice(int index, LinkedList& other){
+    if (this == &other || index < 0 || index > m_length) return false;
+    if (other.m_length == 0) return true;
+    if (index == 0) {
+        other.m_tail -> next = m_head;
+        m_head = other.m_head;
+        if (m_length == 0) m_tail = other.m_tail;
+    }
+    else if (index == m_length) {
+        m_tail -> next = other.m_head;
+        m_tail = other.m_tail;
+    }
+    else {
+        Node* before {get(index - 1)};
+        other.m_tail -> next = before -> next;
+        before -> next = other.m_head;
+    }
+    m_length += std::exchange(other.m_length, 0);
+    other.m_head = nullptr;
+    other.m_tail = nullptr;
+    __forgetPositions();
+    other.__forgetPositions();
+    return true;
+}
+
+/* Counts the links to a Node starting no more than s_nearBytes after the
+ * end of the Node before it.
+ * O(n). Walks the List once.
+ */
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::Locality LinkedList<T, Allocator>::locality() const {
+    Locality result {};
+    for (Node* temp {m_head}; temp && temp -> next; temp = temp -> next) {
+        ++result.links;
+        auto end {reinterpret_cast<std::uintptr_t>(temp + 1)};
+        auto next {reinterpret_cast<std::uintptr_t>(temp -> next)};
+        if (next >= end && next - end <= s_nearBytes) ++result.nearLinks;
+    }
+    return result;
+}
+
+/* Moves every value into a new Node, laid out in list order, and frees the
+ * old Nodes, so a walk down the List reads memory front to back. The new
+ * Nodes are all allocated before any old one is freed, so the allocator
+ * hands out fresh memory rather than the holes the List left, and are then
+ * sorted by address in case it didn't. Nodes are still allocated and freed
+ * one at a time, so any Allocator works. The values stay the same, but
+ * pointers to the old Nodes, and iterators, are left dangling.
+ * If memory runs out the List is left as it was and nothing is moved.
+ * O(n log n), and O(n) extra memory while it runs.
+ */
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::CompactStats LinkedList<T, Allocator>::compact(){
+    CompactStats stats {};
+    stats.before = locality();
+    stats.after = stats.before;
+    std::vector<Node*> nodes {};
+    try {
+        nodes.reserve(static_cast<std::size_t>(m_length));
+        for (int i {0}; i < m_length; ++i) nodes.push_back(NodeTraits::allocate(m_allocator, 1));
+    } catch (const std::bad_alloc&) {
+        for (Node* node : nodes) NodeTraits::deallocate(m_allocator, node, 1);
+        return stats;
+    }
+    if (!std::ranges::is_sorted(nodes)) std::ranges::sort(nodes);
+    Node* old {m_head};
+    Node** link {&m_head};
+    for (Node* node : nodes) {
+        NodeTraits::construct(m_allocator, node, std::in_place, std::move(old -> value));
+        *link = node;
+        link = &(node -> next);
+        Node* after {old -> next};
+        __destroyNode(old);
+        old = after;
+    }
+    if (!nodes.empty()) m_tail = nodes.back();
+    __forgetPositions();
+    stats.nodesMoved = nodes.size();
+    stats.bytesMoved = nodes.size() * sizeof(Node);
+    stats.after = locality();
+    return stats;
+}
+
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(const LinkedList& source){
     if (this != &source) {
+        if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+            __clear();
+            m_allocator = source.m_allocator;
+        }
         deepCopy(source);
     }
     return *this;
 }
 
+/* Move assignment. Takes the source's Nodes and leaves it empty, unless the
+ * two Lists' allocators differ and can't be swapped. Nodes can't change
+ * allocator, so then the values are moved across one at a time.
+ */
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(LinkedList&& source)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value){
+    if (this == &source) return *this;
+    __clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(source.m_allocator);
+    }
+    else if constexpr (!NodeTraits::is_always_equal::value) {
+        if (m_allocator != source.m_allocator) {
+            for (T& value : source) {emplace_back(std::move(value));}
+            source.__clear();
+            return *this;
+        }
+    }
+    m_head = std::exchange(source.m_head, nullptr);
+    m_tail = std::exchange(source.m_tail, nullptr);
+    m_length = std::exchange(source.m_length, 0);
+    m_cursor = std::exchange(source.m_cursor, nullptr);
+    m_cursorIndex = std::exchange(source.m_cursorIndex, 0);
+    m_skip = std::move(source.m_skip);
+    return *this;
+}
+
+// Swaps the Nodes of two Lists. Their allocators must be equal or propagate.
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::swap(LinkedList& other) noexcept{
+    if constexpr (NodeTraits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, other.m_allocator);
+    }
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_length, other.m_length);
+    std::swap(m_cursor, other.m_cursor);
+    std::swap(m_cursorIndex, other.m_cursorIndex);
+    std::swap(m_skip, other.m_skip);
+}
+
+/* Allocates a Node with the List's allocator and builds its value from args
+ * in place. A single T argument is copied or moved in.
+ */
+template <typename T, typename Allocator>
+template <typename... Args>
+LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::__createNode(Args&&... args){
+    Node* node {NodeTraits::allocate(m_allocator, 1)};
+    NodeTraits::construct(m_allocator, node, std::in_place, std::forward<Args>(args)...);
+    return node;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__destroyNode(Node* node){
+    NodeTraits::destroy(m_allocator, node);
+    NodeTraits::deallocate(m_allocator, node, 1);
+}
+
+// Releases every Node and leaves the List empty.
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__clear(){
+    Node* temp {m_head};
+    while(m_head){
+        m_head = m_head->next;
+        __destroyNode(temp);
+        temp = m_head;
+    }
+    m_tail = nullptr;
+    m_length = 0;
+    __forgetPositions();
+}
+
+/* Merges two sorted runs into one by relinking their Nodes. Ties go to left,
+ * which keeps the merge stable when left holds the earlier Nodes. The new
+ * tail is the tail of whichever run was left over. The next Node is picked
+ * with selects rather than a branch, which random keys would mispredict.
+ */
+template <typename T, typename Allocator>
+template <typename Compare>
+LinkedList<T, Allocator>::Run LinkedList<T, Allocator>::__mergeRuns(Run left, Run right, Compare& compare){
+    if (!left.head) return right;
+    if (!right.head) return left;
+    Node* head {nullptr};
+    Node** link {&head};
+    Node* first {left.head};
+    Node* second {right.head};
+    while (first && second) {
+        bool takeSecond {static_cast<bool>(compare(second -> value, first -> value))};
+        Node* taken {takeSecond ? second : first};
+        *link = taken;
+        link = &(taken -> next);
+        Node* after {taken -> next};
+        first = takeSecond ? first : after;
+        second = takeSecond ? after : second;
+    }
+    *link = first ? first : second;
+    return Run{head, first ? left.tail : right.tail};
+}
+
+// Drops the cursor and leaves the skip index to be rebuilt, after a change
+// that moved Nodes to new indexes wholesale.
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__forgetPositions(){
+    m_cursor = nullptr;
+    m_cursorIndex = 0;
+    if (m_skip) m_skip -> stale = true;
+}
+
+// Points a checkpoint at every stride'th Node, walking the List once.
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__rebuildSkipIndex() {
+    std::vector<Checkpoint>& checkpoints {m_skip -> checkpoints};
+    checkpoints.clear();
+    Node* temp {m_head};
+    for (int i {0}; temp; ++i, temp = temp -> next) {
+        if (i > 0 && i % m_skip -> stride == 0) checkpoints.push_back(Checkpoint{temp, i});
+    }
+    m_skip -> stale = false;
+}
+
+/* Adds checkpoints between the one before position (or the head) and the one
+ * at position (or the end of the List) until they are no more than
+ * 2 * stride Nodes apart.
+ */
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__fillSkipGap(std::size_t position) {
+    std::vector<Checkpoint>& checkpoints {m_skip -> checkpoints};
+    int stride {m_skip -> stride};
+    Checkpoint start {position == 0 ? Checkpoint{m_head, 0} : checkpoints[position - 1]};
+    int end {position < checkpoints.size() ? checkpoints[position].index : m_length};
+    while (end - start.index > 2 * stride) {
+        Node* temp {start.node};
+        for (int i {0}; i < stride; ++i) temp = temp -> next;
+        start = Checkpoint{temp, start.index + stride};
+        checkpoints.insert(checkpoints.begin() + static_cast<std::ptrdiff_t>(position), start);
+        ++position;
+    }
+}
+
+/* Renumbers the checkpoints after a Node was inserted at index.
+ * O(1) at the end of the List, otherwise O(n / stride).
+ */
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__skipInserted(int index){
+    if (!m_skip || m_skip -> stale) return;
+    std::vector<Checkpoint>& checkpoints {m_skip -> checkpoints};
+    if (index == m_length - 1) {
+        // appended; the tail becomes a checkpoint once it is far enough on
+        int last {checkpoints.empty() ? 0 : checkpoints.back().index};
+        if (index - last >= m_skip -> stride) checkpoints.push_back(Checkpoint{m_tail, index});
+        return;
+    }
+    auto first {std::ranges::lower_bound(checkpoints, index, {}, &Checkpoint::index)};
+    for (auto it {first}; it != checkpoints.end(); ++it) ++(it -> index);
+    __fillSkipGap(static_cast<std::size_t>(first - checkpoints.begin()));
+}
+
+/* Drops any checkpoint on a Node unlinked from index, and renumbers the rest.
+ * O(1) at the end of the List, otherwise O(n / stride).
+ */
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::__skipErased(const Node* node, int index){
+    if (!m_skip || m_skip -> stale) return;
+    std::vector<Checkpoint>& checkpoints {m_skip -> checkpoints};
+    if (index == m_length) {
+        if (!checkpoints.empty() && checkpoints.back().node == node) checkpoints.pop_back();
+        return;
+    }
+    auto first {std::ranges::lower_bound(checkpoints, index, {}, &Checkpoint::index)};
+    if (first != checkpoints.end() && first -> node == node) first = checkpoints.erase(first);
+    for (auto it {first}; it != checkpoints.end(); ++it) --(it -> index);
+    __fillSkipGap(static_cast<std::size_t>(first - checkpoints.begin()));
+}
+
 } // end namespace sjd
 #endif
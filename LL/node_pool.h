@@ -0,0 +1,226 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+/* Sam Drew ~ 2025
+ * Node Pool and Pool Allocator implementation in C++
+ * ---
+ *  A fixed-size slot pool, and a standard allocator on top of it, used by the
+ *  linked containers to store their Nodes. Written by me, for my own
+ *  edification in data structures and algorithms and C++.
+ *
+ *  Every slot in a pool is the same size, so a slot handed back can serve
+ *  the very next allocation: it goes on a free list and comes straight off
+ *  it again. New slots are carved out of large blocks with a pointer bump,
+ *  so appending to a list costs a few instructions rather than a trip to
+ *  the global allocator. Each thread gets its own pool for each Node size,
+ *  so the free lists need no locks. The price is that memory must be freed
+ *  on the thread that allocated it, so a container using these pools has to
+ *  stay on one thread. Debug builds check that it does.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace sjd {
+
+/* Node Pool class.
+ *
+ *  Hands out slots of one size and alignment. A pool is single threaded:
+ *  nothing in it is locked or atomic, and it must only ever be used from
+ *  one thread at a time. PoolAllocator gives every thread a pool of its own
+ *  instead. A slot may only be handed back to the pool it came from. The
+ *  pool can't tell a slot from another pool, so its live count would drop
+ *  for a slot it never handed out, wrapping below zero, and release() could
+ *  then free blocks that are still in use.
+ *  release() frees every block at once, but only once every slot has been
+ *  handed back.
+ *  Example:
+ *      sjd::NodePool pool {sizeof(Node), alignof(Node)};
+ *      void* slot {pool.allocate()};       // carved from the first block
+ *      pool.deallocate(slot);              // slot is now free for reuse
+ *      pool.release();                     // true, the block is freed
+ */
+class NodePool {
+public:
+    NodePool(std::size_t slotSize, std::size_t slotAlign)
+    : m_slotAlign {std::max(slotAlign, alignof(FreeSlot))}
+    , m_slotSize {__roundUp(std::max(slotSize, sizeof(FreeSlot)), m_slotAlign)}
+    {
+    }
+
+    // Blocks holding live slots are left alone rather than freed under them.
+    // For a thread's pool that leak is permanent, so it is reported.
+    ~NodePool() {
+        if (release()) {return;}
+        std::cerr << "sjd::NodePool: " << m_live << " slots still in use, leaking "
+                  << capacityBytes() << " bytes\n";
+        for (Block& block : m_blocks) {block.release();}
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // number of slots currently handed out
+    std::size_t size() const { return m_live; }
+
+    // bytes of memory reserved by the pool
+    std::size_t capacityBytes() const { return m_capacity * m_slotSize; }
+
+    std::size_t slotSize() const { return m_slotSize; }
+
+    void* allocate() {
+        FreeSlot* slot {m_free};
+        if (slot) {
+            m_free = slot -> next;
+        }
+        else {
+            if (m_bump == m_end) {__grow();}
+            slot = reinterpret_cast<FreeSlot*>(m_bump);
+            m_bump += m_slotSize;
+        }
+        ++m_live;
+        return slot;
+    }
+
+    // slot must have come from this pool's allocate(), on this thread
+    void deallocate(void* slot) {
+        if (!slot) {return;}
+        FreeSlot* freed {static_cast<FreeSlot*>(slot)};
+        freed -> next = m_free;
+        m_free = freed;
+        --m_live;
+    }
+
+    /* Frees every block at once.
+     * Returns false, and frees nothing, while any slot is still handed out.
+     */
+    bool release() {
+        if (m_live != 0) {return false;}
+        m_blocks.clear();
+        m_free = nullptr;
+        m_bump = nullptr;
+        m_end = nullptr;
+        m_capacity = 0;
+        m_nextBlock = s_firstBlock;
+        return true;
+    }
+
+    // The calling thread's pool for slots of Size bytes aligned to Align.
+    template <std::size_t Size, std::size_t Align>
+    static NodePool& local() {
+        thread_local NodePool pool {Size, Align};
+        return pool;
+    }
+
+private:
+    // A slot on the free list holds the link to the next free slot.
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    struct BlockDeleter {
+        std::size_t align {};
+        void operator()(std::byte* block) const { ::operator delete(block, std::align_val_t{align}); }
+    };
+    using Block = std::unique_ptr<std::byte[], BlockDeleter>;
+
+    static constexpr std::size_t s_firstBlock {64};
+    static constexpr std::size_t s_maxBlockBytes {std::size_t{1} << 20};
+
+    std::size_t m_slotAlign;
+    std::size_t m_slotSize;
+    std::vector<Block> m_blocks {};
+    FreeSlot* m_free {nullptr};         // singly linked list of freed slots
+    std::byte* m_bump {nullptr};        // next untouched slot in the newest block
+    std::byte* m_end {nullptr};         // one past the end of the newest block
+    std::size_t m_live {0};
+    std::size_t m_capacity {0};
+    std::size_t m_nextBlock {s_firstBlock};
+
+    static std::size_t __roundUp(std::size_t size, std::size_t align) {
+        return (size + align - 1) / align * align;
+    }
+
+    // Blocks double in size up to around a megabyte so small lists stay small.
+    void __grow() {
+        std::size_t bytes {m_nextBlock * m_slotSize};
+        m_blocks.emplace_back(static_cast<std::byte*>(::operator new(bytes, std::align_val_t{m_slotAlign})),
+                              BlockDeleter{m_slotAlign});
+        m_bump = m_blocks.back().get();
+        m_end = m_bump + bytes;
+        m_capacity += m_nextBlock;
+        m_nextBlock = std::max(std::min(m_nextBlock * 2, s_maxBlockBytes / m_slotSize), m_nextBlock);
+    }
+};
+
+/* Pool Allocator template class.
+ *
+ *  A standard allocator that serves single objects, which is all a linked
+ *  container ever asks for, from a NodePool for their size. Anything larger
+ *  goes to std::allocator. Each allocator holds the pool of the thread that
+ *  constructed it, and two allocators compare equal only when they share a
+ *  pool, so on one thread containers can swap and splice freely.
+ *  Moving or swapping a container takes its allocator along with its Nodes,
+ *  and copying one gives the copy the calling thread's pool.
+ *
+ *  Thread safety: a pool has no locks, so a Node must be freed on the thread
+ *  that allocated it. A container using PoolAllocator must not be handed to
+ *  another thread, whether it is moved, swapped, spliced into another
+ *  container or destroyed there. Debug builds assert that every allocate()
+ *  and deallocate() happens on the allocator's own thread. Use
+ *  std::allocator for containers that cross threads.
+ *  Example:
+ *      using List = sjd::LinkedList<int, sjd::PoolAllocator<int>>;
+ *      List myList {3};
+ *      myList.append(4);                   // Node from this thread's pool
+ *      sjd::PoolAllocator<List::Node>::pool().size();  // 2
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    PoolAllocator() noexcept : m_pool {&pool()} {}
+
+    // Allocators for other types are only ever converted on their own
+    // thread, so this thread's pool for T is the one to use.
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept : m_pool {&pool()} {}
+
+    T* allocate(std::size_t count) {
+        if (count == 1) {return static_cast<T*>(__ownPool().allocate());}
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* object, std::size_t count) {
+        if (count == 1) {__ownPool().deallocate(object);}
+        else {std::allocator<T>{}.deallocate(object, count);}
+    }
+
+    // A copied container draws from the copying thread's pool.
+    PoolAllocator select_on_container_copy_construction() const { return PoolAllocator{}; }
+
+    // The calling thread's pool for single Ts.
+    static NodePool& pool() { return NodePool::local<sizeof(T), alignof(T)>(); }
+
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator& b) { return a.m_pool == b.m_pool; }
+
+private:
+    NodePool* m_pool;       // the constructing thread's pool for single Ts
+
+    NodePool& __ownPool() const {
+        assert(m_pool == &pool() && "PoolAllocator used off the thread that made it");
+        return *m_pool;
+    }
+};
+
+} // end namespace sjd
+#endif
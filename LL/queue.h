@@ -16,8 +16,13 @@
  *  ---
  */
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <new>
+#include <type_traits>
+#include <utility>
 
 namespace sjd {
 
@@ -31,95 +36,186 @@ namespace sjd {
  *  Example:
  *      sjd::Queue myQueue {3};     // myList: [3]
  *      myQueue.enqueue(4);         // myList: [3, 4]
- *      myQueue.dequeue(2);         // myList: [4]
+ *      myQueue.dequeue();          // myList: [4]
+ *
+ *  begin() and end() give forward iterators from the front of the queue to
+ *  one past the back; head() and tail() give the front and back Nodes.
+ *  Nodes are allocated with Allocator, rebound to Node. std::allocator is
+ *  the default; sjd::PoolAllocator (node_pool.h) serves them from a
+ *  per-thread pool, for containers that stay on one thread.
+ *  dequeue() hands the front Node over as a NodeHandle, which returns it to
+ *  the allocator when it goes out of scope.
+ *  Values passed as rvalues are moved into their Nodes and emplace() builds
+ *  a value straight into its Node. Moving or swapping a whole queue just
+ *  hands its Nodes over.
  *
  *  NOTE: A Class like this is already implemented in the standard C++ library 
  *  as the std::list container. Prefer to use the standard container for all 
  *  collaborative work. 
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Queue {
 
     struct Node {
         T value {};
         Node* next {nullptr};
+
+        // Builds the value straight from args, whatever T's constructors are.
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+        // Nodes stay where they were allocated and are never copied.
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
     };
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
 public:
 
+    // Returns a dequeued Node to the queue's allocator.
+    struct NodeDeleter {
+        [[no_unique_address]] NodeAllocator allocator {};
+        void operator()(Node* node) {
+            NodeTraits::destroy(allocator, node);
+            NodeTraits::deallocate(allocator, node, 1);
+        }
+    };
+    using NodeHandle = std::unique_ptr<Node, NodeDeleter>;
+
+    /* Forward iterator over the values in the queue, front first. Const
+     * iterators give read-only access to the values; iterators convert to
+     * them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        explicit Iterator(Node* node) : m_node {node} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_node}; }
+
+        reference operator*() const { return m_node -> value; }
+        pointer operator->() const { return &(m_node -> value); }
+
+        Iterator& operator++() {
+            m_node = m_node -> next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_node == other.m_node; }
+
+    private:
+        Node* m_node {nullptr};     // nullptr at end()
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
     // constructor + destructor
-    Queue();
+    explicit Queue(const Allocator& allocator = Allocator{});
     ~Queue();
 
     // Copy constructor
     void deepCopy(const Queue& source);
-    Queue(const Queue& source) { deepCopy(source); }
+    Queue(const Queue& source)
+    : m_allocator {NodeTraits::select_on_container_copy_construction(source.m_allocator)}
+    {
+        deepCopy(source);
+    }
+
+    // Move constructor. Takes the source's Nodes and leaves it empty.
+    Queue(Queue&& source) noexcept
+    : m_allocator {std::move(source.m_allocator)}
+    , m_head {std::exchange(source.m_head, nullptr)}
+    , m_tail {std::exchange(source.m_tail, nullptr)}
+    , m_length {std::exchange(source.m_length, 0)}
+    {
+    }
 
     // accessors
-    Node* begin() { return m_head; }
-    Node* end() { return m_tail; }
-    int length() { return m_length; }
+    Node* head() const { return m_head; }
+    Node* tail() const { return m_tail; }
+    iterator begin() { return iterator{m_head}; }
+    iterator end() { return iterator{}; }
+    const_iterator begin() const { return const_iterator{m_head}; }
+    const_iterator end() const { return const_iterator{}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    int length() const { return m_length; }
+    Allocator get_allocator() const { return Allocator(m_allocator); }
 
     void printQueue();
 
-    bool enqueue(const T& value);
+    bool enqueue(const T& value) { return emplace(value); }
+    bool enqueue(T&& value) { return emplace(std::move(value)); }
 
-    Node* dequeue();
+    // Adds a value built from args to the back of the queue.
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    NodeHandle dequeue();
 
     Queue& operator=(const Queue& source);
 
+    Queue& operator=(Queue&& source)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value);
+
+    void swap(Queue& other) noexcept;
+    friend void swap(Queue& a, Queue& b) noexcept { a.swap(b); }
+
 private:
+    [[no_unique_address]] NodeAllocator m_allocator {};
     Node* m_head {nullptr};
     Node* m_tail {nullptr};
     int m_length {};
+
+    template <typename... Args>
+    Node* __createNode(Args&&... args);
+    void __clear();
 };
 
-template <typename T>
-Queue<T>::Queue()
-    : m_head {nullptr}
+template <typename T, typename Allocator>
+Queue<T, Allocator>::Queue(const Allocator& allocator)
+    : m_allocator {allocator}
+    , m_head {nullptr}
     , m_tail {nullptr}
     , m_length {0}
 {
 }
 
-template <typename T>
-Queue<T>::~Queue() {
-    Node* temp {m_head};
-    while (temp) {
-        temp = temp -> next;
-        delete m_head;
-        m_head = temp;
-    }
+template <typename T, typename Allocator>
+Queue<T, Allocator>::~Queue() {
+    __clear();
 }
 
-template <typename T>
-void Queue<T>::deepCopy(const Queue& source){
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::deepCopy(const Queue& source){
 
-    delete m_head;
-    delete m_tail;
+    __clear();
 
-    m_length = source.m_length;
-
-    if (source.m_head) {
-
-        m_head = new Node{source.m_head -> value};
-        m_tail = m_head;
-        Node* sourceTemp {source.m_head -> next};
-
-        while (sourceTemp) {
-            m_tail -> next = new Node {sourceTemp -> value};
-            sourceTemp = sourceTemp -> next;
-            m_tail = m_tail -> next;
+    Node* sourceTemp {source.m_head};
+    while (sourceTemp) {
+        if (!enqueue(sourceTemp -> value)) {
+            return;
         }
-    }
-    else {
-        m_head = nullptr;
-        m_tail = nullptr;
+        sourceTemp = sourceTemp -> next;
     }
 }
 
-template <typename T>
-void Queue<T>::printQueue() {
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::printQueue() {
     Node* temp {m_head};
     while (temp) {
         std::cout << temp -> value << "\n";
@@ -127,9 +223,10 @@ void Queue<T>::printQueue() {
     }
 }
 
-template <typename T>
-bool Queue<T>::enqueue(const T& value) {
-    Node* newNode {new (std::nothrow) Node {value}};
+template <typename T, typename Allocator>
+template <typename... Args>
+bool Queue<T, Allocator>::emplace(Args&&... args) {
+    Node* newNode {__createNode(std::forward<Args>(args)...)};
     if (!newNode) {
         std::cout << "Could not allocate memory!\n";
         return false;
@@ -145,10 +242,10 @@ bool Queue<T>::enqueue(const T& value) {
     return true;
 }
 
-template <typename T>
-Queue<T>::Node* Queue<T>::dequeue() {
+template <typename T, typename Allocator>
+Queue<T, Allocator>::NodeHandle Queue<T, Allocator>::dequeue() {
     if (m_length == 0) {
-        return nullptr;
+        return NodeHandle {nullptr, NodeDeleter{m_allocator}};
     }
     Node* temp {m_head};
     if (m_length == 1) {
@@ -157,17 +254,92 @@ Queue<T>::Node* Queue<T>::dequeue() {
     m_head = m_head -> next;
     temp -> next = nullptr;
     --m_length;
-    return temp;
+    return NodeHandle {temp, NodeDeleter{m_allocator}};
 }
 
-template <typename T>
-Queue<T>& Queue<T>::operator=(const Queue& source){
+template <typename T, typename Allocator>
+Queue<T, Allocator>& Queue<T, Allocator>::operator=(const Queue& source){
     if (this != &source) {
+        if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+            __clear();
+            m_allocator = source.m_allocator;
+        }
         deepCopy(source);
     }
     return *this;
 }
 
+/* Move assignment. Takes the source's Nodes and leaves it empty, unless the
+ * two queues' allocators differ and can't be swapped. Nodes can't change
+ * allocator, so then the values are moved across one at a time.
+ */
+template <typename T, typename Allocator>
+Queue<T, Allocator>& Queue<T, Allocator>::operator=(Queue&& source)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value) {
+    if (this == &source) {
+        return *this;
+    }
+    __clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(source.m_allocator);
+    }
+    else if constexpr (!NodeTraits::is_always_equal::value) {
+        if (m_allocator != source.m_allocator) {
+            for (T& value : source) {
+                emplace(std::move(value));
+            }
+            source.__clear();
+            return *this;
+        }
+    }
+    m_head = std::exchange(source.m_head, nullptr);
+    m_tail = std::exchange(source.m_tail, nullptr);
+    m_length = std::exchange(source.m_length, 0);
+    return *this;
+}
+
+// Swaps the Nodes of two queues. Their allocators must be equal or propagate.
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::swap(Queue& other) noexcept {
+    if constexpr (NodeTraits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, other.m_allocator);
+    }
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_length, other.m_length);
+}
+
+/* Allocates a Node with the queue's allocator and builds its value from args
+ * in place. A single T argument is copied or moved in.
+ * Returns nullptr if memory runs out.
+ */
+template <typename T, typename Allocator>
+template <typename... Args>
+Queue<T, Allocator>::Node* Queue<T, Allocator>::__createNode(Args&&... args) {
+    Node* node {nullptr};
+    try {
+        node = NodeTraits::allocate(m_allocator, 1);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+    NodeTraits::construct(m_allocator, node, std::in_place, std::forward<Args>(args)...);
+    return node;
+}
+
+// Releases every Node and leaves the queue empty.
+template <typename T, typename Allocator>
+void Queue<T, Allocator>::__clear() {
+    Node* temp {m_head};
+    while (temp) {
+        temp = temp -> next;
+        NodeTraits::destroy(m_allocator, m_head);
+        NodeTraits::deallocate(m_allocator, m_head, 1);
+        m_head = temp;
+    }
+    m_tail = nullptr;
+    m_length = 0;
+}
+
 
 } // end namespace sjd
 #endif
@@ -15,7 +15,13 @@
  *  compile with C++20 or newer.
  */
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 /* Stack template class.
  *  Holds a single object type in a stack of one or more objects
@@ -27,7 +33,18 @@
  *  Example:
  *      sjd::Stack myStack {3};     // myList: [3]
  *      myStack.push(4);            // myList: [4, 3]
- *      myStack.pop(2);             // myList: [3]
+ *      myStack.pop();              // myList: [3]
+ *
+ *  begin() and end() give forward iterators from the top of the stack to one
+ *  past the bottom; top() gives the top Node.
+ *  Nodes are allocated with Allocator, rebound to Node. std::allocator is
+ *  the default; sjd::PoolAllocator (node_pool.h) serves them from a
+ *  per-thread pool, for containers that stay on one thread.
+ *  pop() hands the top Node over as a NodeHandle, which returns it to the
+ *  allocator when it goes out of scope.
+ *  Values passed as rvalues are moved into their Nodes and emplace() builds
+ *  a value straight into its Node. Moving or swapping a whole stack just
+ *  hands its Nodes over.
  *
  *  NOTE: A Class like this is already implemented in the standard C++ library 
  *  as the std::list container. Prefer to use the standard container for all 
@@ -36,83 +53,187 @@
 
 namespace sjd {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Stack {
 
     struct Node {
         T value {};
         Node* next {nullptr};
+
+        // Builds the value straight from args, whatever T's constructors are.
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+        // Nodes stay where they were allocated and are never copied.
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
     };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
 public:
 
+    // Returns a popped Node to the stack's allocator.
+    struct NodeDeleter {
+        [[no_unique_address]] NodeAllocator allocator {};
+        void operator()(Node* node) {
+            NodeTraits::destroy(allocator, node);
+            NodeTraits::deallocate(allocator, node, 1);
+        }
+    };
+    using NodeHandle = std::unique_ptr<Node, NodeDeleter>;
+
+    /* Forward iterator over the values in the stack, top first. Const
+     * iterators give read-only access to the values; iterators convert to
+     * them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        explicit Iterator(Node* node) : m_node {node} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_node}; }
+
+        reference operator*() const { return m_node -> value; }
+        pointer operator->() const { return &(m_node -> value); }
+
+        Iterator& operator++() {
+            m_node = m_node -> next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_node == other.m_node; }
+
+    private:
+        Node* m_node {nullptr};     // nullptr at end()
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
     // constructor and destructor
-    Stack(const T& value);
+    Stack(const T& value, const Allocator& allocator = Allocator{});
+    Stack(T&& value, const Allocator& allocator = Allocator{});
     ~Stack();
 
     // Copy constructor
     void deepCopy(const Stack& source);
-    Stack(const Stack& source) { deepCopy(source); }
+    Stack(const Stack& source)
+    : m_allocator {NodeTraits::select_on_container_copy_construction(source.m_allocator)}
+    {
+        deepCopy(source);
+    }
+
+    // Move constructor. Takes the source's Nodes and leaves it empty.
+    Stack(Stack&& source) noexcept
+    : m_allocator {std::move(source.m_allocator)}
+    , m_top {std::exchange(source.m_top, nullptr)}
+    , m_height {std::exchange(source.m_height, 0)}
+    {
+    }
 
     // accessors
-    Node* top() { return m_top; }
-    int length() { return m_height; }
+    Node* top() const { return m_top; }
+    iterator begin() { return iterator{m_top}; }
+    iterator end() { return iterator{}; }
+    const_iterator begin() const { return const_iterator{m_top}; }
+    const_iterator end() const { return const_iterator{}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    int length() const { return m_height; }
+    Allocator get_allocator() const { return Allocator(m_allocator); }
 
     void printStack();
 
-    bool push(const T& value);
+    bool push(const T& value) { return emplace(value); }
+    bool push(T&& value) { return emplace(std::move(value)); }
 
-    Node* pop();
+    // Pushes a value built from args onto the top of the stack.
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    NodeHandle pop();
 
     Stack& operator=(const Stack& source);
 
+    Stack& operator=(Stack&& source)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value);
+
+    void swap(Stack& other) noexcept;
+    friend void swap(Stack& a, Stack& b) noexcept { a.swap(b); }
+
 private:
+    [[no_unique_address]] NodeAllocator m_allocator {};
     Node* m_top {nullptr};
     int m_height {};
+
+    template <typename... Args>
+    Node* __createNode(Args&&... args);
+    void __clear();
 };
 
-template <typename T>
-Stack<T>::Stack(const T& value)
-    : m_top { new Node {value}}
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack(const T& value, const Allocator& allocator)
+    : m_allocator {allocator}
+    , m_top {__createNode(value)}
     , m_height {1}
 {
+    if (!m_top) {
+        m_height = 0;
+        std::cout << "Could not allocate memory!\n";
+    }
 }
 
-template <typename T>
-Stack<T>::~Stack() {
-    Node* temp {m_top};
-    while (temp) {
-        temp = temp -> next;
-        delete m_top;
-        m_top = temp;
+template <typename T, typename Allocator>
+Stack<T, Allocator>::Stack(T&& value, const Allocator& allocator)
+    : m_allocator {allocator}
+    , m_top {__createNode(std::move(value))}
+    , m_height {1}
+{
+    if (!m_top) {
+        m_height = 0;
+        std::cout << "Could not allocate memory!\n";
     }
 }
 
-template <typename T>
-void Stack<T>::deepCopy(const Stack& source){
-
-    delete m_top;
-
-    m_height = source.m_height;
+template <typename T, typename Allocator>
+Stack<T, Allocator>::~Stack() {
+    __clear();
+}
 
-    if (source.m_top) {
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::deepCopy(const Stack& source){
 
-        m_top = new Node{source.m_top -> value};
-        Node* temp {m_top};
-        Node* sourceTemp {source.m_top -> next};
+    __clear();
 
-        while (sourceTemp) {
-            temp -> next = new Node {sourceTemp -> value};
-            sourceTemp = sourceTemp -> next;
-            temp = temp -> next;
+    Node** slot {&m_top};
+    Node* sourceTemp {source.m_top};
+    while (sourceTemp) {
+        *slot = __createNode(sourceTemp -> value);
+        if (!*slot) {
+            std::cout << "Could not allocate memory!\n";
+            return;
         }
-    }
-    else {
-        m_top = nullptr;
+        ++m_height;
+        slot = &((*slot) -> next);
+        sourceTemp = sourceTemp -> next;
     }
 }
 
-template <typename T>
-void Stack<T>::printStack() {
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::printStack() {
     Node* temp {m_top};
     while (temp) {
         std::cout << temp->value << "\n";
@@ -120,29 +241,117 @@ void Stack<T>::printStack() {
     }
 }
 
-template <typename T>
-bool Stack<T>::push(const T& value) {
-    Node* newNode {new Node {value, m_top}};
+template <typename T, typename Allocator>
+template <typename... Args>
+bool Stack<T, Allocator>::emplace(Args&&... args) {
+    Node* newNode {__createNode(std::forward<Args>(args)...)};
+    if (!newNode) {
+        std::cout << "Could not allocate memory!\n";
+        return false;
+    }
+    newNode -> next = m_top;
     m_top = newNode;
     ++m_height;
     return true;
 }
 
-template <typename T>
-Stack<T>::Node* Stack<T>::pop() {
+// Returns an empty handle if the stack is empty.
+template <typename T, typename Allocator>
+Stack<T, Allocator>::NodeHandle Stack<T, Allocator>::pop() {
     Node* temp {m_top};
-    m_top = m_top -> next;
-    temp -> next = nullptr;
-    --m_height;
-    return temp;
+    if (temp) {
+        m_top = m_top -> next;
+        temp -> next = nullptr;
+        --m_height;
+    }
+    return NodeHandle {temp, NodeDeleter{m_allocator}};
 }
 
-template <typename T>
-Stack<T>& Stack<T>::operator=(const Stack& source){
+template <typename T, typename Allocator>
+Stack<T, Allocator>& Stack<T, Allocator>::operator=(const Stack& source){
     if (this != &source) {
+        if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+            __clear();
+            m_allocator = source.m_allocator;
+        }
         deepCopy(source);
     }
     return *this;
 }
+
+/* Move assignment. Takes the source's Nodes and leaves it empty, unless the
+ * two stacks' allocators differ and can't be swapped. Nodes can't change
+ * allocator, so then the values are moved across one at a time, top first.
+ */
+template <typename T, typename Allocator>
+Stack<T, Allocator>& Stack<T, Allocator>::operator=(Stack&& source)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value) {
+    if (this == &source) {
+        return *this;
+    }
+    __clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(source.m_allocator);
+    }
+    else if constexpr (!NodeTraits::is_always_equal::value) {
+        if (m_allocator != source.m_allocator) {
+            Node** slot {&m_top};
+            for (T& value : source) {
+                *slot = __createNode(std::move(value));
+                if (!*slot) {
+                    std::cout << "Could not allocate memory!\n";
+                    break;
+                }
+                ++m_height;
+                slot = &((*slot) -> next);
+            }
+            source.__clear();
+            return *this;
+        }
+    }
+    m_top = std::exchange(source.m_top, nullptr);
+    m_height = std::exchange(source.m_height, 0);
+    return *this;
+}
+
+// Swaps the Nodes of two stacks. Their allocators must be equal or propagate.
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::swap(Stack& other) noexcept {
+    if constexpr (NodeTraits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, other.m_allocator);
+    }
+    std::swap(m_top, other.m_top);
+    std::swap(m_height, other.m_height);
+}
+
+/* Allocates an unlinked Node with the stack's allocator and builds its value
+ * from args in place. A single T argument is copied or moved in.
+ * Returns nullptr if memory runs out.
+ */
+template <typename T, typename Allocator>
+template <typename... Args>
+Stack<T, Allocator>::Node* Stack<T, Allocator>::__createNode(Args&&... args) {
+    Node* node {nullptr};
+    try {
+        node = NodeTraits::allocate(m_allocator, 1);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+    NodeTraits::construct(m_allocator, node, std::in_place, std::forward<Args>(args)...);
+    return node;
+}
+
+// Releases every Node and leaves the stack empty.
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::__clear() {
+    Node* temp {m_top};
+    while (temp) {
+        temp = temp -> next;
+        NodeTraits::destroy(m_allocator, m_top);
+        NodeTraits::deallocate(m_allocator, m_top, 1);
+        m_top = temp;
+    }
+    m_height = 0;
+}
 } // end namespace sjd
 #endif
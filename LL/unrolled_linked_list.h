@@ -0,0 +1,620 @@
+#ifndef UNROLLED_LINKED_LIST_H
+#define UNROLLED_LINKED_LIST_H
+/* Sam Drew ~ 2025
+ * Unrolled Linked List implementation in C++
+ * ---
+ *  This is a simple implementation of an Unrolled Linked List. Written by me,
+ *  for my own edification in data structures and algorithms and C++.
+ *
+ *  WARNING: Do not use this library in projects. Instead use the standard C++
+ *  std::deque or std::vector.
+ *
+ *  A sjd::LinkedList Node holds one value and one pointer, so a list of ints
+ *  is mostly pointers and every value is a fresh cache miss. Here each Node
+ *  holds a small array of up to N values instead. Walking the list touches
+ *  one Node per N values, and the pointer is shared between all of them. A
+ *  full Node is split in two when a value is inserted into it, and a Node
+ *  that drops below half full after a delete takes values from the next Node
+ *  or merges with it, so most Nodes stay at least half full.
+ *
+ *  Class templating is used to allow the creation of Linked Lists of any
+ *  object type. This version uses CTAD (Class Type Argument Deduction)
+ *  and doesn't provide deduction guides so will only compile with C++20 or
+ *  newer.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Unrolled Linked List template class.
+ *
+ *  Has the same interface as sjd::LinkedList, except that get() returns a
+ *  pointer to the value itself, as values no longer have a Node each.
+ *  N defaults to as many values as fit in a 64 byte Node alongside its
+ *  count and next pointer, and at least 4.
+ *  Member function implementations can be found below the class declaration.
+ *  Example:
+ *      sjd::UnrolledLinkedList myList {3}; // myList: [3]
+ *      myList.append(4);                   // myList: [3, 4]
+ *      myList.prepend(2);                  // myList: [2, 3, 4]
+ *      myList.set(0, 1);                   // myList: [1, 3, 4]
+ *      *myList.get(2);                     // 4
+ *
+ *  begin() and end() give forward iterators over the values, with end()
+ *  one past the last; head() and tail() give the first and last Nodes.
+ *  Nodes are allocated with Allocator, rebound to Node, as in sjd::LinkedList.
+ *  Values passed as rvalues are moved into their slots, and moving or
+ *  swapping a whole List just hands its Nodes over.
+ *
+ *  NOTE: A Class like this isn't in the standard C++ library, but std::deque
+ *  also stores its values in fixed size blocks. Prefer to use the standard
+ *  containers for all collaborative work.
+ */
+namespace sjd {
+template <typename T,
+          std::size_t N = std::max<std::size_t>((64 - 2 * sizeof(void*)) / sizeof(T), 4),
+          typename Allocator = std::allocator<T>>
+class UnrolledLinkedList {
+    static_assert(N > 0, "Nodes must hold at least one value");
+public:
+
+    /* Each Node holds up to N values, in order, in the front of its slots.
+     * The slots are raw storage: only the first count hold a live value, so
+     * T needn't be default constructible and an empty slot costs nothing.
+     */
+    struct Node {
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        Slot slots[N];
+        std::size_t count {0};      // number of values in use
+        Node* next {nullptr};
+
+        Node() {}                   // leaves the slots raw
+        ~Node() {
+            for (std::size_t i {0}; i < count; ++i) std::destroy_at(&value(i));
+        }
+        Node(const Node&) = delete;
+        Node& operator=(const Node&) = delete;
+
+        T* address(std::size_t i) { return reinterpret_cast<T*>(slots[i].storage); }
+        T& value(std::size_t i) { return *std::launder(address(i)); }
+        const T& value(std::size_t i) const { return *std::launder(reinterpret_cast<const T*>(slots[i].storage)); }
+    };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    /* Forward iterator over the values in the List. It steps through a
+     * Node's array and only follows a pointer at the end of each Node. Const
+     * iterators give read-only access to the values; iterators convert to
+     * them.
+     */
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        Iterator(Node* node, std::size_t offset) : m_node {node}, m_offset {offset} {}
+
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>{m_node, m_offset}; }
+
+        reference operator*() const { return m_node -> value(m_offset); }
+        pointer operator->() const { return &(m_node -> value(m_offset)); }
+
+        Iterator& operator++() {
+            if (++m_offset == m_node -> count) {
+                m_node = m_node -> next;
+                m_offset = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old {*this};
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return m_node == other.m_node && m_offset == other.m_offset;
+        }
+
+    private:
+        Node* m_node {nullptr};     // nullptr at end()
+        std::size_t m_offset {0};   // position within m_node's values
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // accessors
+    Node* head() const { return m_head; }
+    Node* tail() const { return m_tail; }
+    iterator begin() { return {m_head, 0}; }
+    iterator end() { return {}; }
+    const_iterator begin() const { return {m_head, 0}; }
+    const_iterator end() const { return {}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    int length() const { return m_length; }
+    Allocator get_allocator() const { return Allocator(m_allocator); }
+    static constexpr std::size_t nodeCapacity() { return N; }
+
+    // constructors & destructor
+    explicit UnrolledLinkedList(const T& value, const Allocator& allocator = Allocator{});
+    explicit UnrolledLinkedList(T&& value, const Allocator& allocator = Allocator{});
+    ~UnrolledLinkedList();
+
+    // Copy constructor
+    void deepCopy(const UnrolledLinkedList& source);
+    UnrolledLinkedList(const UnrolledLinkedList& source)
+    : m_allocator {NodeTraits::select_on_container_copy_construction(source.m_allocator)}
+    {
+        deepCopy(source);
+    }
+
+    // Move constructor. Takes the source's Nodes and leaves it empty.
+    UnrolledLinkedList(UnrolledLinkedList&& source) noexcept
+    : m_allocator {std::move(source.m_allocator)}
+    , m_head {std::exchange(source.m_head, nullptr)}
+    , m_tail {std::exchange(source.m_tail, nullptr)}
+    , m_length {std::exchange(source.m_length, 0)}
+    {
+    }
+
+    void printList() const;
+
+    bool append(const T& value) { return __append(value); }
+    bool append(T&& value) { return __append(std::move(value)); }
+
+    void deleteLast();
+
+    void deleteFirst();
+
+    void prepend(const T& value) { __prepend(value); }
+    void prepend(T&& value) { __prepend(std::move(value)); }
+
+    T* get(int index);
+
+    const T* get(int index) const;
+
+    bool set(int index, const T& value);
+
+    bool insert(int index, const T& value) { return __insert(index, value); }
+    bool insert(int index, T&& value) { return __insert(index, std::move(value)); }
+
+    void deleteNode(int index);
+
+    void reverse();
+
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& source);
+
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& source)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value);
+
+    void swap(UnrolledLinkedList& other) noexcept;
+    friend void swap(UnrolledLinkedList& a, UnrolledLinkedList& b) noexcept { a.swap(b); }
+
+private:
+
+    [[no_unique_address]] NodeAllocator m_allocator {};
+    Node* m_head {nullptr};     // pointer to the first Node in the List.
+    Node* m_tail {nullptr};     // pointer to the last Node in the List.
+    int m_length {};            // The number of values in the List.
+
+    template <typename V>
+    bool __append(V&& value);
+    template <typename V>
+    void __prepend(V&& value);
+    template <typename V>
+    bool __insert(int index, V&& value);
+    Node* __locate(std::size_t& offset, Node** before = nullptr) const;
+    template <typename V>
+    static void __emplaceAt(Node* node, std::size_t offset, V&& value);
+    static void __eraseAt(Node* node, std::size_t offset);
+    static void __relocate(Node* from, std::size_t fromOffset, Node* to, std::size_t toOffset);
+    void __refill(Node* node, Node* before);
+    Node* __createNode();
+    void __destroyNode(Node* node);
+    void __clear();
+
+};
+
+
+
+//---
+/*  Implementation of member functions included as most are templated. The
+ *  compiler therefore requires the full definition included.*/
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>::UnrolledLinkedList(const T& value, const Allocator& allocator)
+    : m_allocator {allocator}
+{
+    append(value);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>::UnrolledLinkedList(T&& value, const Allocator& allocator)
+    : m_allocator {allocator}
+{
+    append(std::move(value));
+}
+
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>::~UnrolledLinkedList(){
+    __clear();
+}
+
+/* Replaces the contents of this List with copies of the source's values.
+ * O(n + m). The copy's Nodes are packed full, however sparse the source's are.
+ */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::deepCopy(const UnrolledLinkedList& source){
+    __clear();
+    for (const T& value : source) {
+        append(value);
+    }
+}
+
+/* prints the linked list items. One item per line.
+ * O(n). Every value is visited once. */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::printList() const {
+    for (const T& value : *this) {
+        std::cout << value << "\n";
+    }
+}
+
+/* Adds the given value to the end of the List.
+ * O(1). The value goes in the last Node, or in a new Node if that one is
+ * full. Appended values are packed, so a list built by appending uses as few
+ * Nodes as it can.
+ */
+template <typename T, std::size_t N, typename Allocator>
+template <typename V>
+bool UnrolledLinkedList<T, N, Allocator>::__append(V&& value) {
+    if (!m_tail || m_tail -> count == N) {
+        Node* newNode {__createNode()};
+        if (m_tail) {
+            m_tail -> next = newNode;
+        }
+        else {
+            m_head = newNode;
+        }
+        m_tail = newNode;
+    }
+    __emplaceAt(m_tail, m_tail -> count, std::forward<V>(value));
+    ++m_length;
+    return true;
+}
+
+/* Deletes the last value in the List.
+ * O(n / N). The Node before the last must be found in case the last empties.
+ */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::deleteLast(){
+    deleteNode(m_length - 1);
+}
+
+/* Removes the first value from the front of the List.
+ * O(N). The rest of the first Node's values shift down one place.
+ */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::deleteFirst(){
+    deleteNode(0);
+}
+
+/* Adds the given value to the front of the List.
+ * O(N). The first Node's values shift up one place to make room, or the
+ * value starts a new first Node if that one is full.
+ */
+template <typename T, std::size_t N, typename Allocator>
+template <typename V>
+void UnrolledLinkedList<T, N, Allocator>::__prepend(V&& value){
+    if (!m_head || m_head -> count == N) {
+        Node* newNode {__createNode()};
+        newNode -> next = m_head;
+        m_head = newNode;
+        if (!m_tail) m_tail = newNode;
+    }
+    __emplaceAt(m_head, 0, std::forward<V>(value));
+    ++m_length;
+}
+
+/* Returns a pointer to the value at the position given, or nullptr if there
+ * is no such position.
+ * O(n / N). Whole Nodes are skipped by their counts.
+ */
+template <typename T, std::size_t N, typename Allocator>
+T* UnrolledLinkedList<T, N, Allocator>::get(int index) {
+    return const_cast<T*>(std::as_const(*this).get(index));
+}
+
+// As get(), but only reads, so the value can't be changed through it.
+template <typename T, std::size_t N, typename Allocator>
+const T* UnrolledLinkedList<T, N, Allocator>::get(int index) const {
+    if (index < 0 || index >= m_length) {
+        return nullptr;
+    }
+    std::size_t offset {static_cast<std::size_t>(index)};
+    const Node* node {__locate(offset)};
+    return &node -> value(offset);
+}
+
+/* Change the value at the given index.
+ * O(n / N). As get().
+ */
+template <typename T, std::size_t N, typename Allocator>
+bool UnrolledLinkedList<T, N, Allocator>::set(int index, const T& value){
+    T* temp {get(index)};
+    if (temp) {
+        *temp = value;
+        return true;
+    }
+    return false;
+}
+
+/* inserts the given value before the given index in the List.
+ * O(n / N + N). If the Node the value belongs in is full, its upper half
+ * moves out to a new Node after it first.
+ */
+template <typename T, std::size_t N, typename Allocator>
+template <typename V>
+bool UnrolledLinkedList<T, N, Allocator>::__insert(int index, V&& value){
+    if (index < 0 || index > m_length) return false;
+    if (index == m_length) return __append(std::forward<V>(value));
+
+    std::size_t offset {static_cast<std::size_t>(index)};
+    Node* node {__locate(offset)};
+    if (node -> count == N) {
+        // built first, in case it is a copy of a value the split moves
+        T temp(std::forward<V>(value));
+        Node* newNode {__createNode()};
+        std::size_t keep {N / 2};
+        for (std::size_t i {keep}; i < N; ++i) {
+            __relocate(node, i, newNode, i - keep);
+        }
+        newNode -> count = N - keep;
+        node -> count = keep;
+        newNode -> next = node -> next;
+        node -> next = newNode;
+        if (m_tail == node) m_tail = newNode;
+        if (offset > keep) {
+            offset -= keep;
+            node = newNode;
+        }
+        __emplaceAt(node, offset, std::move(temp));
+    }
+    else {
+        __emplaceAt(node, offset, std::forward<V>(value));
+    }
+    ++m_length;
+    return true;
+}
+
+/* Deletes the value at the given index.
+ * O(n / N + N). The Node it was in is topped back up from the next Node if
+ * it falls below half full.
+ */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::deleteNode(int index){
+    if ( index < 0 || index >= m_length ) return;
+
+    std::size_t offset {static_cast<std::size_t>(index)};
+    Node* before {nullptr};
+    Node* node {__locate(offset, &before)};
+    __eraseAt(node, offset);
+    --m_length;
+    __refill(node, before);
+}
+
+/* flips the List around so that head is tail and tail is head.
+ * O(n). Every Node's link is turned round and its values reversed, each
+ * pair swapped by moving one out to a temporary.
+ */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::reverse() {
+    Node* node {m_head};
+    Node* before {nullptr};
+    while (node) {
+        for (std::size_t i {0}, j {node -> count}; i + 1 < j; ++i) {
+            --j;
+            T temp {std::move(node -> value(i))};
+            std::destroy_at(&node -> value(i));
+            __relocate(node, j, node, i);
+            std::construct_at(node -> address(j), std::move(temp));
+        }
+        Node* after {node -> next};
+        node -> next = before;
+        before = node;
+        node = after;
+    }
+    m_tail = m_head;
+    m_head = before;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>& UnrolledLinkedList<T, N, Allocator>::operator=(const UnrolledLinkedList& source){
+    if (this != &source) {
+        if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+            __clear();
+            m_allocator = source.m_allocator;
+        }
+        deepCopy(source);
+    }
+    return *this;
+}
+
+/* Move assignment. Takes the source's Nodes and leaves it empty, unless the
+ * two Lists' allocators differ and can't be swapped. Nodes can't change
+ * allocator, so then the values are moved across one at a time.
+ */
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>& UnrolledLinkedList<T, N, Allocator>::operator=(UnrolledLinkedList&& source)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value){
+    if (this == &source) return *this;
+    __clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(source.m_allocator);
+    }
+    else if constexpr (!NodeTraits::is_always_equal::value) {
+        if (m_allocator != source.m_allocator) {
+            for (T& value : source) {__append(std::move(value));}
+            source.__clear();
+            return *this;
+        }
+    }
+    m_head = std::exchange(source.m_head, nullptr);
+    m_tail = std::exchange(source.m_tail, nullptr);
+    m_length = std::exchange(source.m_length, 0);
+    return *this;
+}
+
+// Swaps the Nodes of two Lists. Their allocators must be equal or propagate.
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::swap(UnrolledLinkedList& other) noexcept{
+    if constexpr (NodeTraits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, other.m_allocator);
+    }
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_length, other.m_length);
+}
+
+/* Finds the Node holding the value at position offset, which must be in the
+ * List, and turns offset into that value's position within the Node. The
+ * Node before it is written to before, if given.
+ */
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>::Node* UnrolledLinkedList<T, N, Allocator>::__locate(std::size_t& offset, Node** before) const {
+    Node* prev {nullptr};
+    Node* node {m_head};
+    while (offset >= node -> count) {
+        offset -= node -> count;
+        prev = node;
+        node = node -> next;
+    }
+    if (before) *before = prev;
+    return node;
+}
+
+/* Builds a value in node's slot at offset, first moving the values from
+ * offset on up one slot. node must have a free slot.
+ * O(N). Only T's move constructor is needed to shift values. The new value
+ * is built before anything moves in case it is a copy of one that will.
+ */
+template <typename T, std::size_t N, typename Allocator>
+template <typename V>
+void UnrolledLinkedList<T, N, Allocator>::__emplaceAt(Node* node, std::size_t offset, V&& value){
+    if (offset == node -> count) {
+        std::construct_at(node -> address(offset), std::forward<V>(value));
+    }
+    else {
+        T temp(std::forward<V>(value));
+        for (std::size_t i {node -> count}; i > offset; --i) {
+            __relocate(node, i - 1, node, i);
+        }
+        std::construct_at(node -> address(offset), std::move(temp));
+    }
+    ++node -> count;
+}
+
+// Destroys the value at offset in node and moves the values after it down.
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::__eraseAt(Node* node, std::size_t offset){
+    std::destroy_at(&node -> value(offset));
+    for (std::size_t i {offset + 1}; i < node -> count; ++i) {
+        __relocate(node, i, node, i - 1);
+    }
+    --node -> count;
+}
+
+// Moves the value in one slot into a raw slot, leaving the first raw.
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::__relocate(Node* from, std::size_t fromOffset, Node* to, std::size_t toOffset){
+    std::construct_at(to -> address(toOffset), std::move(from -> value(fromOffset)));
+    std::destroy_at(&from -> value(fromOffset));
+}
+
+/* Keeps node at least half full after a delete. If node and the Node after it
+ * fit in one they merge, otherwise node takes just enough values from the
+ * front of the next. A Node left empty is unlinked from the List.
+ */
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::__refill(Node* node, Node* before){
+    Node* next {node -> next};
+    if (next && node -> count < N / 2) {
+        if (node -> count + next -> count <= N) {
+            for (std::size_t i {0}; i < next -> count; ++i) {
+                __relocate(next, i, node, node -> count + i);
+            }
+            node -> count += next -> count;
+            next -> count = 0;
+            node -> next = next -> next;
+            if (m_tail == next) m_tail = node;
+            __destroyNode(next);
+        }
+        else {
+            std::size_t take {N / 2 - node -> count};
+            for (std::size_t i {0}; i < take; ++i) {
+                __relocate(next, i, node, node -> count + i);
+            }
+            for (std::size_t i {take}; i < next -> count; ++i) {
+                __relocate(next, i, next, i - take);
+            }
+            node -> count += take;
+            next -> count -= take;
+        }
+    }
+    if (node -> count == 0) {
+        if (before) {
+            before -> next = node -> next;
+        }
+        else {
+            m_head = node -> next;
+        }
+        if (m_tail == node) m_tail = before;
+        __destroyNode(node);
+    }
+}
+
+// Allocates an empty Node with the List's allocator.
+template <typename T, std::size_t N, typename Allocator>
+UnrolledLinkedList<T, N, Allocator>::Node* UnrolledLinkedList<T, N, Allocator>::__createNode(){
+    Node* node {NodeTraits::allocate(m_allocator, 1)};
+    NodeTraits::construct(m_allocator, node);
+    return node;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::__destroyNode(Node* node){
+    NodeTraits::destroy(m_allocator, node);
+    NodeTraits::deallocate(m_allocator, node, 1);
+}
+
+// Releases every Node and leaves the List empty.
+template <typename T, std::size_t N, typename Allocator>
+void UnrolledLinkedList<T, N, Allocator>::__clear(){
+    Node* temp {m_head};
+    while(m_head){
+        m_head = m_head -> next;
+        __destroyNode(temp);
+        temp = m_head;
+    }
+    m_tail = nullptr;
+    m_length = 0;
+}
+
+} // end namespace sjd
+#endif
@@ -0,0 +1,203 @@
+/*  quick benchmark main.cpp to time the tree containers
+ *  Usage: ./benchbst [number of keys]
+ */
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+#include "../BST/b_tree.h"
+#include "../BST/binary_search_tree.h"
+
+/*  The tree as it was before Nodes moved into a sjd::NodeArena. Every Node is
+ *  a separate std::make_shared allocation and every hop copies a shared_ptr.
+ *  Kept here as the baseline the arena tree is measured against.
+ */
+template <typename T>
+class SharedPtrTree {
+public:
+    struct Node {
+        T value {};
+        std::shared_ptr<Node> left {nullptr};
+        std::shared_ptr<Node> right {nullptr};
+    };
+
+    bool insert(const T& value) {
+        auto newNode {std::make_shared<Node>(value)};
+        if (!m_root) {m_root = newNode; return true;}
+        std::shared_ptr<Node> temp {m_root};
+        while (true) {
+            if (newNode -> value == temp -> value) {return false;}
+            if (newNode -> value < temp -> value) {
+                if (!(temp -> left)) {temp -> left = newNode; return true;}
+                temp = temp -> left;
+            }
+            else {
+                if (!(temp -> right)) {temp -> right = newNode; return true;}
+                temp = temp -> right;
+            }
+        }
+    }
+
+    bool contains(const T& value) const {
+        std::shared_ptr<Node> temp {m_root};
+        while (temp) {
+            if (value < temp -> value) {temp = temp -> left;}
+            else if (value > temp -> value) {temp = temp -> right;}
+            else {return true;}
+        }
+        return false;
+    }
+
+private:
+    std::shared_ptr<Node> m_root {nullptr};
+};
+
+template <typename Fn>
+double timeNsPerOp(std::size_t ops, Fn&& fn) {
+    auto start {std::chrono::steady_clock::now()};
+    fn();
+    auto stop {std::chrono::steady_clock::now()};
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count())
+        / static_cast<double>(ops);
+}
+
+template <typename Tree>
+void benchTree(const std::string& name, const std::vector<std::uint32_t>& keys,
+               const std::vector<std::uint32_t>& queries) {
+    std::size_t found {0};
+    auto tree {std::make_unique<Tree>()};
+    double insertNs {timeNsPerOp(keys.size(), [&]{
+        for (std::uint32_t key : keys) {tree -> insert(key);}
+    })};
+    double containsNs {timeNsPerOp(queries.size(), [&]{
+        for (std::uint32_t query : queries) {found += tree -> contains(query);}
+    })};
+    double destroyNs {timeNsPerOp(keys.size(), [&]{ tree.reset(); })};
+    std::cout << name << ": insert " << insertNs << " ns/op, contains "
+              << containsNs << " ns/op, destroy " << destroyNs << " ns/op ("
+              << found << " found)\n";
+}
+
+void benchFrozen(const std::string& name, const std::vector<std::uint32_t>& keys,
+                 const std::vector<std::uint32_t>& queries) {
+    sjd::AVLTree<std::uint32_t> tree {};
+    for (std::uint32_t key : keys) {tree.insert(key);}
+    sjd::FrozenSet<std::uint32_t> set {};
+    double freezeNs {timeNsPerOp(keys.size(), [&]{ set = tree.freeze(); })};
+    std::size_t found {0};
+    double containsNs {timeNsPerOp(queries.size(), [&]{
+        for (std::uint32_t query : queries) {found += set.contains(query);}
+    })};
+    std::unique_ptr<bool[]> results {std::make_unique<bool[]>(queries.size())};
+    std::span<bool> resultSpan {results.get(), queries.size()};
+    double batchNs {timeNsPerOp(queries.size(), [&]{ set.containsBatch(queries, resultSpan); })};
+    std::cout << name << ": freeze " << freezeNs << " ns/op, contains " << containsNs
+              << " ns/op, containsBatch " << batchNs << " ns/op (" << found << " found)\n";
+}
+
+void benchFiltered(const std::string& name, const std::vector<std::uint32_t>& keys,
+                   const std::vector<std::uint32_t>& queries) {
+    sjd::AVLTree<std::uint32_t> tree {keys.begin(), keys.end()};
+    tree.enableFilter(10.0);
+    std::size_t found {0};
+    double containsNs {timeNsPerOp(queries.size(), [&]{
+        for (std::uint32_t query : queries) {found += tree.contains(query);}
+    })};
+    auto stats {tree.filterStats()};
+    std::cout << name << ": contains " << containsNs << " ns/op (" << found << " found), filter "
+              << stats.bytes / 1024 << " KiB, " << stats.bitsPerValue << " bits/value, "
+              << 100.0 * stats.observedFalsePositiveRate << "% false positives\n";
+}
+
+void benchParallel(const std::string& name, const std::vector<std::uint32_t>& keys) {
+    sjd::AVLTree<std::uint32_t> tree {keys.begin(), keys.end()};
+    std::uint64_t sequential {0};
+    double sequentialNs {timeNsPerOp(tree.size(), [&]{
+        for (std::uint32_t key : tree) {sequential += key;}
+    })};
+    std::uint64_t parallel {0};
+    double parallelNs {timeNsPerOp(tree.size(), [&]{
+        parallel = tree.parallelReduce(std::uint64_t{0}, std::plus<>{});
+    })};
+    std::cout << name << ": sum " << sequentialNs << " ns/value, parallelReduce "
+              << parallelNs << " ns/value on " << sjd::WorkStealingPool::shared().size()
+              << " threads (" << (sequential == parallel ? "match" : "MISMATCH") << ")\n";
+}
+
+/* Zipf distributed lookups: the rank r key is asked for in proportion to
+ * 1 / r^skew, so a few keys take most of the queries, as in a cache. Ranks
+ * are drawn from the cumulative weights with a binary search and mapped onto
+ * the keys through a shuffle, so hot keys sit all over the tree.
+ */
+std::vector<std::uint32_t> zipfQueries(const std::vector<std::uint32_t>& keys, std::size_t count,
+                                       double skew, std::mt19937& gen) {
+    std::vector<double> cumulative(keys.size());
+    double total {0.0};
+    for (std::size_t rank {0}; rank < keys.size(); ++rank) {
+        total += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+        cumulative[rank] = total;
+    }
+    std::vector<std::uint32_t> byRank {keys};
+    std::ranges::shuffle(byRank, gen);
+    std::uniform_real_distribution<double> dist {0.0, total};
+    std::vector<std::uint32_t> queries(count);
+    for (std::uint32_t& query : queries) {
+        auto rank {std::ranges::lower_bound(cumulative, dist(gen)) - cumulative.begin()};
+        query = byRank[std::min(static_cast<std::size_t>(rank), byRank.size() - 1)];
+    }
+    return queries;
+}
+
+// contains only splays through a non-const tree, so Tree isn't made const here
+template <typename Tree>
+void benchSkewed(const std::string& name, const std::vector<std::uint32_t>& keys,
+                 const std::vector<std::uint32_t>& queries) {
+    Tree tree {keys.begin(), keys.end()};
+    std::size_t found {0};
+    double containsNs {timeNsPerOp(queries.size(), [&]{
+        for (std::uint32_t query : queries) {found += tree.contains(query);}
+    })};
+    std::cout << name << ": zipf contains " << containsNs << " ns/op (" << found << " found)\n";
+}
+
+int main(int argc, char* argv[]) {
+
+    std::size_t count {1'000'000};
+    if (argc > 1) {count = std::strtoull(argv[1], nullptr, 10);}
+
+    std::mt19937 gen {42};
+    std::vector<std::uint32_t> keys(count);
+    for (std::uint32_t& key : keys) {key = static_cast<std::uint32_t>(gen());}
+    std::vector<std::uint32_t> queries {keys};
+    std::ranges::shuffle(queries, gen);
+    for (std::size_t i {0}; i < queries.size(); i += 2) {
+        queries[i] = static_cast<std::uint32_t>(gen());     // roughly half miss
+    }
+
+    std::cout << count << " random uint32 keys\n";
+    std::cout << "node size: shared_ptr " << sizeof(SharedPtrTree<std::uint32_t>::Node)
+              << " B + control block, arena "
+              << sizeof(sjd::BinarySearchTree<std::uint32_t>::Node) << " B\n";
+    benchTree<SharedPtrTree<std::uint32_t>>("shared_ptr tree", keys, queries);
+    benchTree<sjd::BinarySearchTree<std::uint32_t>>("arena tree     ", keys, queries);
+    benchTree<sjd::AVLTree<std::uint32_t>>("arena AVL tree ", keys, queries);
+    benchTree<sjd::BTree<std::uint32_t>>("B-tree         ", keys, queries);
+    benchFrozen("frozen set     ", keys, queries);
+    benchFiltered("filtered AVL   ", keys, queries);
+    benchParallel("AVL tree visit ", keys);
+
+    for (double skew : {0.8, 1.1, 1.4}) {
+        std::vector<std::uint32_t> skewed {zipfQueries(keys, count, skew, gen)};
+        std::cout << "zipf skew " << skew << "\n";
+        benchSkewed<sjd::BinarySearchTree<std::uint32_t>>("arena tree     ", keys, skewed);
+        benchSkewed<sjd::AVLTree<std::uint32_t>>("arena AVL tree ", keys, skewed);
+        benchSkewed<sjd::SplayTree<std::uint32_t>>("splay tree     ", keys, skewed);
+    }
+}
@@ -0,0 +1,157 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "../BST/b_tree.h"
+
+using namespace std::string_literals;
+
+/*  B-Tree Validation function.
+ *  Walks the passed tree to ensure every Node holds a legal number of values
+ *  in sorted order, that the values separate the children correctly and that
+ *  every leaf is at the same depth. Returns the depth of the leaves.
+ */
+template <typename Node, typename T>
+int validateSubtree(const Node* node, bool isRoot, const T* low, const T* high,
+                    std::size_t minDegree) {
+    assert((isRoot || node -> count >= minDegree - 1) && "Node has underflowed.");
+    for (std::size_t i {0}; i < node -> count; ++i) {
+        if (i > 0) {assert(node -> value(i - 1) < node -> value(i) && "values out of order.");}
+        if (low) {assert(*low < node -> value(i) && "value below its range.");}
+        if (high) {assert(node -> value(i) < *high && "value above its range.");}
+    }
+    if (node -> leaf) {return 1;}
+    int depth {-1};
+    for (std::size_t i {0}; i <= node -> count; ++i) {
+        const T* childLow {i == 0 ? low : &node -> value(i - 1)};
+        const T* childHigh {i == node -> count ? high : &node -> value(i)};
+        int childDepth {validateSubtree(node -> children[i], false, childLow, childHigh, minDegree)};
+        assert((depth < 0 || depth == childDepth) && "leaves at different depths.");
+        depth = childDepth;
+    }
+    return depth + 1;
+}
+
+template <typename T, std::size_t Fanout>
+bool isValidBTree(const sjd::BTree<T, Fanout>& tree) {
+    if (!tree.root()) {
+        assert(tree.size() == 0 && "empty tree must have size 0.");
+        return true;
+    }
+    validateSubtree(tree.root(), true, static_cast<const T*>(nullptr),
+                    static_cast<const T*>(nullptr), sjd::BTree<T, Fanout>::s_minDegree);
+    assert(tree.dfsInOrder().size() == tree.size() && "size is stale.");
+    return true;
+}
+
+template <int reps, std::size_t Fanout>
+bool testrandomagainstset() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    std::uniform_int_distribution<int> dist {0, reps / 2};
+    sjd::BTree<int, Fanout> tree {};
+    std::set<int> reference {};
+    for (int i {0}; i < reps; ++i) {
+        int value {dist(gen)};
+        if (gen() % 3 == 0) {
+            if (tree.remove(value) != (reference.erase(value) == 1)) {return false;}
+        }
+        else {
+            if (tree.insert(value) != reference.insert(value).second) {return false;}
+        }
+        if (tree.contains(value) != reference.contains(value)) {return false;}
+    }
+    std::vector<int> expected {reference.begin(), reference.end()};
+    if (tree.dfsInOrder() != expected) {return false;}
+
+    return isValidBTree(tree);
+}
+
+template <int reps>
+bool testsortedinsertremove() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::BTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {
+        if (!tree.insert(i)) {return false;}
+    }
+    if (tree.insert(0)) {return false;}
+    if (tree.size() != static_cast<std::size_t>(reps)) {return false;}
+    isValidBTree(tree);
+    for (int i {0}; i < reps; ++i) {
+        if (!tree.remove(i) || tree.contains(i)) {return false;}
+    }
+    if (tree.root() != nullptr || tree.size() != 0 || tree.remove(0)) {return false;}
+
+    return isValidBTree(tree);
+}
+
+// A value with no default constructor and no operator==, only operator<.
+class Label {
+public:
+    explicit Label(int key) : m_key {key}, m_text {"label " + std::to_string(key)} {}
+    bool operator<(const Label& other) const { return m_key < other.m_key; }
+    int key() const { return m_key; }
+private:
+    int m_key;
+    std::string m_text;     // owns heap memory, so a missed destructor leaks
+};
+
+template <int reps>
+bool testrawvalues() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::vector<int> keys(reps);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937 {reps});
+    sjd::BTree<Label, 6> tree {};
+    for (int key : keys) {
+        if (!tree.insert(Label{key}) || tree.insert(Label{key})) {return false;}
+    }
+    sjd::BTree<Label, 6> copy {tree};
+    for (int key : keys) {
+        if (key % 2 == 0 && !tree.remove(Label{key})) {return false;}
+    }
+    for (int key {0}; key < reps; ++key) {
+        if (tree.contains(Label{key}) != (key % 2 == 1) || !copy.contains(Label{key})) {return false;}
+    }
+    std::vector<Label> values {tree.dfsInOrder()};
+    for (std::size_t i {0}; i < values.size(); ++i) {
+        if (values[i].key() != 2 * static_cast<int>(i) + 1) {return false;}
+    }
+
+    return isValidBTree(tree) && isValidBTree(copy) && copy.size() == static_cast<std::size_t>(reps);
+}
+
+int main() {
+
+    sjd::BTree<std::string, 4> myStringTree {};
+    myStringTree.insert("Vermillion"s);
+    myStringTree.insert("rose-quartz"s);
+    myStringTree.insert("Purple"s);
+    myStringTree.insert("Amber"s);
+    myStringTree.insert("Teal"s);
+    std::cout << myStringTree << "\n";
+    myStringTree.remove("Purple"s);
+    std::cout << myStringTree << "\n";
+    sjd::BTree<std::string, 4> copyStringTree {myStringTree};
+    copyStringTree.insert("Purple"s);
+    std::cout << copyStringTree << "\n";
+    assert(isValidBTree(myStringTree) && isValidBTree(copyStringTree) && "Failed to copy correctly");
+    assert(!myStringTree.contains("Purple"s) && copyStringTree.contains("Purple"s));
+
+    assert((testrandomagainstset<5000, 4>()) && "Failed to match std::set with Fanout 4");
+    assert((testrandomagainstset<5000, 6>()) && "Failed to match std::set with Fanout 6");
+    assert((testrandomagainstset<20000, 64>()) && "Failed to match std::set with Fanout 64");
+    assert(testsortedinsertremove<10000>() && "Failed to insert and remove sorted values");
+    assert(testrawvalues<2000>() && "Failed to store values with no default constructor");
+
+    std::cout << "All tests succeeded.\n";
+}
@@ -0,0 +1,171 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../BST/binary_search_map.h"
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+/*  Binary Search Map Validation function.
+ *  Checks that the entries come out of the map in strictly increasing key
+ *  order and that there are as many as the map says.
+ */
+template <typename K, typename V, typename Compare, typename Balance>
+bool isValidMap(const sjd::BinarySearchMap<K, V, Compare, Balance>& map) {
+    std::size_t count {0};
+    const K* previous {nullptr};
+    for (const auto& entry : map) {
+        if (previous) {
+            assert(Compare{}(*previous, entry.key) && "entries out of order.");
+        }
+        previous = &entry.key;
+        ++count;
+    }
+    assert(count == map.size() && "size is stale.");
+    return true;
+}
+
+// Counts how often it is made, copied and moved.
+struct Counted {
+    static inline int s_constructed {0};
+    static inline int s_copied {0};
+    static inline int s_moved {0};
+
+    int value {};
+
+    Counted() { ++s_constructed; }
+    explicit Counted(int v) : value {v} { ++s_constructed; }
+    Counted(const Counted& source) : value {source.value} { ++s_copied; }
+    Counted(Counted&& source) noexcept : value {source.value} { ++s_moved; }
+    Counted& operator=(const Counted& source) { value = source.value; ++s_copied; return *this; }
+    Counted& operator=(Counted&& source) noexcept { value = source.value; ++s_moved; return *this; }
+    ~Counted() = default;
+
+    static void reset() { s_constructed = s_copied = s_moved = 0; }
+};
+
+template <int reps>
+bool testagainstmap() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::BinarySearchMap<int, int> map {};
+    std::map<int, int> reference {};
+    for (int i {0}; i < reps; ++i) {
+        int key {static_cast<int>(gen() % (2 * reps))};
+        int value {static_cast<int>(gen() % 100)};
+        switch (i % 4) {
+            case 0:
+                if (map.try_emplace(key, value).second != reference.try_emplace(key, value).second) {return false;}
+                break;
+            case 1:
+                if (map.insert_or_assign(key, value).second != reference.insert_or_assign(key, value).second) {return false;}
+                break;
+            case 2:
+                map[key] += value;
+                reference[key] += value;
+                break;
+            default:
+                if (map.remove(key) != (reference.erase(key) == 1)) {return false;}
+        }
+    }
+    if (map.size() != reference.size()) {return false;}
+    for (int key {0}; key < 2 * reps; ++key) {
+        auto it {map.find(key)};
+        auto expected {reference.find(key)};
+        if ((it == map.end()) != (expected == reference.end())) {return false;}
+        if (it != map.end() && it -> value != expected -> second) {return false;}
+    }
+
+    return isValidMap(map);
+}
+
+bool testinplace() {
+
+    // values are built in their Nodes and never copied or moved
+    sjd::BinarySearchMap<int, Counted> map {};
+    Counted::reset();
+    for (int i {0}; i < 100; ++i) {
+        if (!map.try_emplace(i, i).second) {return false;}
+    }
+    if (map.try_emplace(5, 0).second || map.find(5) -> value.value != 5) {return false;}
+    map[200].value = 7;
+    if (Counted::s_constructed != 101 || Counted::s_copied != 0 || Counted::s_moved != 0) {return false;}
+
+    // insert_or_assign assigns through the handle it found on the way down
+    Counted::reset();
+    auto [it, added] {map.insert_or_assign(5, Counted{50})};
+    if (added || it -> value.value != 50 || Counted::s_moved != 1 || Counted::s_copied != 0) {return false;}
+
+    // handles let the value be changed without a second lookup
+    map.find(6) -> value.value = 60;
+    if (map[6].value != 60) {return false;}
+
+    // move-only values and transparent lookups
+    sjd::BinarySearchMap<std::string, std::unique_ptr<int>, std::less<>> owners {};
+    owners.try_emplace("a"s, new int {1});
+    owners.insert_or_assign("b"s, std::make_unique<int>(2));
+    owners["c"s] = std::make_unique<int>(3);
+    if (!owners.contains("b"sv) || *owners.find("c"sv) -> value != 3) {return false;}
+    if (owners.try_emplace("a"s, nullptr).second || !owners.find("a"sv) -> value) {return false;}
+    if (!owners.remove("a"s) || owners.contains("a"sv)) {return false;}
+
+    return isValidMap(map) && isValidMap(owners);
+}
+
+// Handles must keep pointing at their own entries as others come and go,
+// including when an entry with two children is removed.
+template <int reps>
+bool testhandles() {
+
+    sjd::BinarySearchMap<int, int> map {};
+    std::vector<decltype(map.find(0))> handles {};
+    for (int i {0}; i < reps; ++i) {
+        handles.push_back(map.try_emplace(i, i * 10).first);
+    }
+    // the odd keys are the inner Nodes of a tree built in order, so most
+    // of them have two children when they are removed
+    std::vector<int> odds {};
+    for (int i {1}; i < reps; i += 2) {odds.push_back(i);}
+    std::shuffle(odds.begin(), odds.end(), std::mt19937 {3});
+    for (int odd : odds) {
+        if (!map.remove(odd)) {return false;}
+        for (int j {0}; j < reps; j += 2) {
+            auto handle {handles[static_cast<std::size_t>(j)]};
+            if (map.find(j) != handle || handle -> value != j * 10) {return false;}
+        }
+    }
+    for (int i {0}; i < reps; i += 2) {
+        auto handle {handles[static_cast<std::size_t>(i)]};
+        handle -> value = -i;
+        if (map[i] != -i) {return false;}
+    }
+    return isValidMap(map);
+}
+
+int main() {
+
+    sjd::BinarySearchMap<int, std::string> myMap {};
+    myMap.try_emplace(2, std::size_t{3}, 'b');
+    myMap[1] = "a";
+    myMap.insert_or_assign(4, "d"s);
+    myMap.insert_or_assign(2, "c"s);
+    std::cout << myMap << "\n";
+    assert(myMap.find(2) -> value == "c"s && "Failed to assign an existing key");
+    assert(myMap.find(3) == myMap.end() && "Failed to report a missing key");
+    assert(myMap.size() == 3 && "Failed to count entries");
+
+    assert(testagainstmap<1000>() && "Failed to match std::map");
+    assert(testinplace() && "Failed to build values in place");
+    assert(testhandles<200>() && "Failed to keep handles valid across removals");
+
+    std::cout << "All tests succeeded.\n";
+}
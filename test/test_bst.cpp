@@ -1,19 +1,645 @@
 /*  quick test main.cpp to run tests on the libraries
  */
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include "../BST/binary_search_tree.h"
 
 using namespace std::string_literals;
+using namespace std::string_view_literals;
 
-/*  Linked List Validation function.
- *  Tests the passed Linked List to ensure head, tail and length members are 
- *  valid and traverses the list fully to ensure the list isn't circular.
+// Nodes only carry the height and size fields that their policies keep
+static_assert(sizeof(void*) != 8 || sizeof(sjd::BinarySearchTree<std::uint32_t>::Node) == 32);
+static_assert(sizeof(void*) != 8 || sizeof(sjd::AVLTree<std::uint32_t>::Node) == 32);
+static_assert(sizeof(void*) != 8 || sizeof(sjd::SplayTree<std::uint32_t>::Node) == 32);
+
+/*  Binary Search Tree Validation function.
+ *  Walks the passed tree to ensure every Node is correctly ordered relative to
+ *  its parent, that the parent pointers are consistent and, for balanced
+ *  trees, that no Node's subtrees differ in height by more than one.
+ *  Returns the height of the subtree.
  */
-template <typename T>
-bool isValidLL(const sjd::BinarySearchTree<T>&) {
-    std::cout << "Not Implemented";
-    return false;
+template <typename Node, typename Compare>
+int validateSubtree(const Node* node, const Node* parent, const Compare& compare) {
+    if (!node) {return 0;}
+    assert(node -> parent == parent && "parent pointer is inconsistent.");
+    if (node -> left) {
+        assert(compare(node -> left -> value, node -> value) && "left child out of order.");
+    }
+    if (node -> right) {
+        assert(compare(node -> value, node -> right -> value) && "right child out of order.");
+    }
+    int leftHeight {validateSubtree(node -> left, node, compare)};
+    int rightHeight {validateSubtree(node -> right, node, compare)};
+    return 1 + std::max(leftHeight, rightHeight);
+}
+
+// Checks every cached subtree size. Returns the size of the subtree.
+template <typename Node>
+std::size_t validateSizes(const Node* node) {
+    if (!node) {return 0;}
+    std::size_t size {1 + validateSizes(node -> left) + validateSizes(node -> right)};
+    assert(node -> size == size && "cached subtree size is stale.");
+    return size;
+}
+
+template <typename T, typename Compare, typename Balance, typename Augmentation>
+bool isValidBST(const sjd::BinarySearchTree<T, Compare, Balance, Augmentation>& bst) {
+    int height {validateSubtree(bst.root(), decltype(bst.root()){nullptr}, Compare{})};
+    if constexpr (std::is_same_v<Balance, sjd::AVLBalanced>) {
+        auto node {bst.root()};
+        if (node) {
+            assert(node -> height == height && "cached height is stale.");
+        }
+    }
+    if constexpr (std::is_same_v<Augmentation, sjd::SubtreeSizes>) {
+        validateSizes(bst.root());
+    }
+    assert(static_cast<std::size_t>(std::ranges::distance(bst)) == bst.size() && "size is stale.");
+    return true;
+}
+
+template <int reps>
+bool testsortedinsertAVL() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::AVLTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {
+        if (!tree.insert(i)) {return false;}
+        isValidBST(tree);
+    }
+    // an AVL tree is never more than ~1.44 log2(n) high
+    if (tree.root() -> height > static_cast<int>(1.45 * std::log2(reps + 2))) {return false;}
+    for (int i {0}; i < reps; ++i) {
+        if (!tree.contains(i)) {return false;}
+    }
+    if (tree.contains(reps)) {return false;}
+    if (tree.insert(reps / 2)) {return false;}
+
+    return isValidBST(tree);
+}
+
+template <int reps>
+bool testremoveAVL() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::AVLTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {
+        tree.insert(i);
+    }
+    for (int i {0}; i < reps; i += 2) {
+        tree.remove(i);
+        isValidBST(tree);
+    }
+    for (int i {0}; i < reps; ++i) {
+        if (tree.contains(i) != (i % 2 == 1)) {return false;}
+    }
+    if (tree.root() -> height > static_cast<int>(1.45 * std::log2(reps + 2))) {return false;}
+
+    return isValidBST(tree);
+}
+
+template <int reps>
+bool testcopy() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::AVLTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {
+        tree.insert(i);
+    }
+    sjd::AVLTree<int> copy {tree};
+    for (int i {0}; i < reps; i += 2) {
+        copy.remove(i);
+    }
+    for (int i {0}; i < reps; ++i) {
+        if (!tree.contains(i)) {return false;}
+        if (copy.contains(i) != (i % 2 == 1)) {return false;}
+    }
+    tree = copy;
+    if (tree.dfsInOrder() != copy.dfsInOrder()) {return false;}
+
+    return isValidBST(tree) && isValidBST(copy);
+}
+
+// Values passed as rvalues are moved into their Nodes, and moving or swapping
+// whole trees hands the Nodes over where they are.
+template <int reps>
+bool testmoves() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::AVLTree<std::string> tree {};
+    for (int i {0}; i < reps; ++i) {
+        std::string value {std::to_string(i) + std::string(32, 'x')};
+        if (!tree.insert(std::move(value)) || !value.empty()) {return false;}
+    }
+    std::string duplicate {"0"s + std::string(32, 'x')};
+    if (tree.insert(std::move(duplicate)) || duplicate.empty()) {return false;}
+    tree.enableFilter(10.0);
+
+    const auto* root {tree.root()};
+    sjd::AVLTree<std::string> moved {std::move(tree)};
+    if (moved.root() != root || moved.size() != static_cast<std::size_t>(reps) || tree.size() != 0 || tree.root()) {return false;}
+    sjd::AVLTree<std::string> assigned {};
+    assigned.insert("old"s);
+    assigned = std::move(moved);
+    if (assigned.root() != root || moved.size() != 0 || assigned.filterStats().bytes == 0) {return false;}
+    swap(tree, assigned);
+    if (tree.root() != root || assigned.size() != 0 || !tree.contains("1"s + std::string(32, 'x'))) {return false;}
+    tree.insert("new"s);
+    moved.insert("new"s);
+    static_assert(std::is_nothrow_move_constructible_v<sjd::AVLTree<std::string>>);
+    static_assert(std::is_nothrow_move_assignable_v<sjd::AVLTree<std::string>>);
+
+    return isValidBST(tree) && isValidBST(moved) && isValidBST(assigned);
+}
+
+template <int reps>
+bool testbulkload() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::vector<int> sorted {};
+    for (int i {0}; i < reps; ++i) {
+        sorted.push_back(2 * i);
+    }
+    sjd::BinarySearchTree<int> tree(sorted.begin(), sorted.end());
+    if (tree.dfsInOrder() != sorted) {return false;}
+    // perfectly balanced: no higher than a complete tree of the same size
+    if (validateSubtree(tree.root(), decltype(tree.root()){nullptr}, std::less<int>{}) != static_cast<int>(std::bit_width(static_cast<unsigned>(reps)))) {return false;}
+
+    // unsorted with duplicates, some of which are already in the tree
+    std::vector<int> extra {};
+    for (int i {reps - 1}; i >= 0; --i) {
+        extra.push_back(2 * i + 1);
+        extra.push_back(2 * i + 1);
+        extra.push_back(2 * i);
+    }
+    if (tree.insertBulk(extra.begin(), extra.end()) != static_cast<std::size_t>(reps)) {return false;}
+    std::vector<int> expected {};
+    for (int i {0}; i < 2 * reps; ++i) {
+        expected.push_back(i);
+    }
+    if (tree.dfsInOrder() != expected) {return false;}
+    if (validateSubtree(tree.root(), decltype(tree.root()){nullptr}, std::less<int>{}) != static_cast<int>(std::bit_width(static_cast<unsigned>(2 * reps)))) {return false;}
+
+    sjd::AVLTree<int> avlTree(expected.rbegin(), expected.rend());
+    avlTree.insert(-1);
+    avlTree.remove(reps);
+
+    return isValidBST(tree) && isValidBST(avlTree);
+}
+
+static_assert(std::bidirectional_iterator<sjd::BinarySearchTree<int>::const_iterator>);
+static_assert(std::ranges::bidirectional_range<sjd::AVLTree<int>>);
+
+template <int reps>
+bool testiterators() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::AVLTree<int> tree {};
+    std::set<int> reference {};
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    for (int i {0}; i < reps; ++i) {
+        int value {static_cast<int>(gen() % (4 * reps))};
+        tree.insert(value);
+        reference.insert(value);
+    }
+    if (!std::ranges::equal(tree, reference)) {return false;}
+    if (!std::equal(tree.rbegin(), tree.rend(), reference.rbegin(), reference.rend())) {return false;}
+    if (*std::prev(tree.end()) != *reference.rbegin()) {return false;}
+
+    for (int query {-1}; query <= 4 * reps; ++query) {
+        auto lower {tree.lower_bound(query)};
+        auto upper {tree.upper_bound(query)};
+        auto expectedLower {reference.lower_bound(query)};
+        auto expectedUpper {reference.upper_bound(query)};
+        if ((lower == tree.end()) != (expectedLower == reference.end())) {return false;}
+        if ((upper == tree.end()) != (expectedUpper == reference.end())) {return false;}
+        if (lower != tree.end() && *lower != *expectedLower) {return false;}
+        if (upper != tree.end() && *upper != *expectedUpper) {return false;}
+        if ((tree.find(query) != tree.end()) != reference.contains(query)) {return false;}
+        auto [first, last] {tree.equal_range(query)};
+        if (std::distance(first, last) != static_cast<std::ptrdiff_t>(reference.count(query))) {return false;}
+    }
+
+    // next 10 values from the middle
+    auto view {tree.range(reps, 2 * reps)};
+    std::vector<int> window {};
+    for (int value : view | std::views::take(10)) {
+        window.push_back(value);
+    }
+    std::vector<int> expected {};
+    for (auto it {reference.lower_bound(reps)}; it != reference.end() && *it < 2 * reps && expected.size() < 10; ++it) {
+        expected.push_back(*it);
+    }
+    if (window != expected) {return false;}
+    if (!tree.range(5, 5).empty()) {return false;}
+
+    sjd::BinarySearchTree<int> empty {};
+    if (empty.begin() != empty.end() || empty.lower_bound(0) != empty.end()) {return false;}
+
+    return isValidBST(tree);
+}
+
+// Orders unique_ptrs by what they point at and can look them up by plain int.
+struct PointeeLess {
+    using is_transparent = void;
+    bool operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const { return *a < *b; }
+    bool operator()(const std::unique_ptr<int>& a, int b) const { return *a < b; }
+    bool operator()(int a, const std::unique_ptr<int>& b) const { return a < *b; }
+};
+
+bool testcomparators() {
+
+    sjd::AVLTree<int, std::greater<int>> descending {};
+    for (int i {0}; i < 100; ++i) {
+        descending.insert(i);
+    }
+    if (descending.insert(50)) {return false;}
+    if (*descending.begin() != 99 || *descending.rbegin() != 0) {return false;}
+    if (*descending.lower_bound(50) != 50 || *descending.upper_bound(50) != 49) {return false;}
+    descending.remove(50);
+    if (descending.contains(50) || descending.size() != 99) {return false;}
+    if (!std::ranges::is_sorted(descending, std::greater<int>{})) {return false;}
+    sjd::FrozenSet<int, std::greater<int>> frozen {descending.freeze()};
+    if (!frozen.contains(99) || frozen.contains(50) || *frozen.lower_bound(50) != 49) {return false;}
+
+    // std::string_view isn't implicitly convertible to std::string, so these
+    // lookups only compile because no std::string is constructed
+    sjd::BinarySearchTree<std::string, std::less<>> strings {};
+    strings.emplace(std::size_t{3}, 'a');
+    strings.insert("bbb"s);
+    std::string moved {"ccc"};
+    strings.insert(std::move(moved));
+    if (!strings.contains("aaa"sv) || strings.contains("zzz"sv)) {return false;}
+    if (*strings.lower_bound("b"sv) != "bbb"s) {return false;}
+    if (strings.find("ccc"sv) == strings.end()) {return false;}
+
+    // move-only values are moved into their Nodes, never copied
+    sjd::BinarySearchTree<std::unique_ptr<int>, PointeeLess> pointers {};
+    pointers.emplace(new int {2});
+    pointers.insert(std::make_unique<int>(1));
+    if (pointers.insert(std::make_unique<int>(2))) {return false;}
+    if (!pointers.contains(1) || !pointers.contains(2) || pointers.contains(3)) {return false;}
+    if (**pointers.begin() != 1) {return false;}
+
+    return isValidBST(descending) && isValidBST(strings);
+}
+
+template <int reps>
+bool testorderstatistics() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 rng {7};
+    std::uniform_int_distribution<int> dist {0, 4 * reps};
+    sjd::OrderStatisticTree<int> tree {};
+    sjd::BinarySearchTree<int, std::less<int>, sjd::Unbalanced, sjd::SubtreeSizes> unbalanced {};
+    std::set<int> reference {};
+    for (int i {0}; i < reps; ++i) {
+        int value {dist(rng)};
+        tree.insert(value);
+        unbalanced.insert(value);
+        reference.insert(value);
+    }
+    for (int i {0}; i < reps / 2; ++i) {
+        int value {dist(rng)};
+        tree.remove(value);
+        unbalanced.remove(value);
+        reference.erase(value);
+    }
+    if (tree.size() != reference.size() || unbalanced.size() != reference.size()) {return false;}
+
+    std::size_t k {0};
+    for (int value : reference) {
+        if (*tree.select(k) != value || *unbalanced.select(k) != value) {return false;}
+        if (tree.rank(value) != k || unbalanced.rank(value) != k) {return false;}
+        ++k;
+    }
+    if (tree.select(k) != tree.end()) {return false;}
+    for (int i {0}; i < reps; ++i) {
+        int low {dist(rng)};
+        int high {dist(rng)};
+        std::size_t expected {low < high ? static_cast<std::size_t>(std::distance(
+            reference.lower_bound(low), reference.lower_bound(high))) : 0};
+        if (tree.countRange(low, high) != expected) {return false;}
+        if (unbalanced.countRange(low, high) != expected) {return false;}
+    }
+
+    // copies and bulk loads come with their sizes already counted
+    sjd::OrderStatisticTree<int> copy {tree};
+    sjd::OrderStatisticTree<int> bulk {reference.begin(), reference.end()};
+    if (*copy.select(reference.size() / 2) != *bulk.select(reference.size() / 2)) {return false;}
+
+    return isValidBST(tree) && isValidBST(unbalanced) && isValidBST(copy) && isValidBST(bulk);
+}
+
+// Sorted inserts leave an unbalanced tree reps levels deep. None of the
+// walks below may recurse per level.
+template <int reps>
+bool testdegenerate() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::BinarySearchTree<std::string> tree {};
+    std::vector<std::string> expected {};
+    for (int i {0}; i < reps; ++i) {
+        expected.push_back(std::to_string(1000000 + i));
+        tree.insert(expected.back());
+    }
+    if (tree.dfsInOrder() != expected) {return false;}
+    if (tree.elementsTopDown().size() != expected.size()) {return false;}
+
+    sjd::RingBuffer<const sjd::BinarySearchTree<std::string>::Node*> queue {};
+    std::size_t visited {0};
+    tree.visitTopDown([&visited](auto) { ++visited; }, queue);
+    std::size_t capacity {queue.capacity()};
+    tree.visitTopDown([&visited](auto) { ++visited; }, queue);
+    if (visited != 2 * expected.size() || queue.capacity() != capacity) {return false;}
+
+    sjd::BinarySearchTree<std::string> copy {tree};
+    for (int i {0}; i < reps; i += 2) {
+        copy.remove(expected[static_cast<std::size_t>(i)]);
+    }
+    if (copy.size() != expected.size() / 2 || tree.size() != expected.size()) {return false;}
+    for (std::size_t i {0}; i < expected.size(); ++i) {
+        if (copy.contains(expected[i]) != (i % 2 == 1)) {return false;}
+    }
+    return true;
+}
+
+template <int reps>
+bool testparallel() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::WorkStealingPool pool {4};
+    sjd::AVLTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {tree.insert(i);}
+
+    std::atomic<long long> sum {0};
+    std::atomic<int> visits {0};
+    tree.parallelForEach([&](int value) {
+        sum += value;
+        ++visits;
+    }, pool);
+    long long expected {static_cast<long long>(reps) * (reps - 1) / 2};
+    if (sum != expected || visits != reps) {return false;}
+    if (tree.parallelReduce(0LL, std::plus<>{}, pool) != expected) {return false;}
+
+    // string concatenation isn't commutative, so this needs the runs combined in order
+    std::string ordered {tree.parallelReduce(std::string{},
+        [](std::string result, int value) { return result + std::to_string(value) + ","; },
+        [](std::string left, const std::string& right) { return left + right; }, pool)};
+    std::string sequential {};
+    for (int value : tree) {sequential += std::to_string(value) + ",";}
+    if (ordered != sequential) {return false;}
+
+    // lopsided trees and the shared pool work just as well
+    sjd::BinarySearchTree<int> lopsided {};
+    for (int i {0}; i < 500; ++i) {lopsided.insert(i);}
+    if (lopsided.parallelReduce(0, std::plus<>{}) != 500 * 499 / 2) {return false;}
+    return sjd::BinarySearchTree<int>{}.parallelReduce(7, std::plus<>{}) == 7;
+}
+
+template <int reps>
+bool testfilter() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::AVLTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {tree.insert(2 * i);}
+    tree.enableFilter(10.0);
+    // odd values were never inserted
+    for (int i {0}; i < reps; ++i) {
+        if (!tree.contains(2 * i) || tree.contains(2 * i + 1)) {return false;}
+    }
+    auto stats {tree.filterStats()};
+    if (stats.queries != 2 * static_cast<std::size_t>(reps)) {return false;}
+    if (stats.rejected + stats.falsePositives != static_cast<std::size_t>(reps)) {return false;}
+    if (stats.observedFalsePositiveRate > 0.05 || stats.estimatedFalsePositiveRate > 0.05) {return false;}
+    if (stats.bytes == 0 || stats.bitsPerValue < 8.0) {return false;}
+
+    // removes and inserts past the filter's capacity keep it in step
+    for (int i {0}; i < reps; i += 2) {tree.remove(2 * i);}
+    for (int i {reps}; i < 4 * reps; ++i) {tree.insert(2 * i);}
+    for (int i {0}; i < 4 * reps; ++i) {
+        bool expected {i >= reps || i % 2 == 1};
+        if (tree.contains(2 * i) != expected || tree.contains(2 * i + 1)) {return false;}
+    }
+    if (tree.filterStats().observedFalsePositiveRate > 0.05) {return false;}
+
+    sjd::AVLTree<int> copy {tree};
+    if (copy.filterStats().bytes == 0 || !copy.contains(2 * reps)) {return false;}
+    copy.disableFilter();
+    if (copy.filterStats().bytes != 0 || !copy.contains(2 * reps)) {return false;}
+
+    return isValidBST(tree);
+}
+
+// Treats strings that differ only in case as equal, which std::hash doesn't.
+struct CaseInsensitiveLess {
+    bool operator()(const std::string& a, const std::string& b) const {
+        return std::ranges::lexicographical_compare(a, b, {}, [](unsigned char c) { return std::tolower(c); },
+                                                    [](unsigned char c) { return std::tolower(c); });
+    }
+};
+
+template <typename Tree>
+concept Filterable = requires (Tree& tree) { tree.enableFilter(); };
+
+// A filter keyed on std::hash would turn away values the comparator finds,
+// so only trees ordered by std::less offer one.
+bool testfiltercomparators() {
+
+    static_assert(Filterable<sjd::AVLTree<std::string>>);
+    static_assert(Filterable<sjd::BinarySearchTree<std::string, std::less<>>>);
+    static_assert(!Filterable<sjd::BinarySearchTree<std::string, CaseInsensitiveLess>>);
+    static_assert(!Filterable<sjd::SplayTree<std::string, CaseInsensitiveLess>>);
+
+    sjd::BinarySearchTree<std::string, CaseInsensitiveLess> tree {};
+    sjd::SplayTree<std::string, CaseInsensitiveLess> splay {};
+    for (int i {0}; i < 100; ++i) {
+        tree.insert("Apple"s + std::to_string(i));
+        splay.insert("Apple"s + std::to_string(i));
+    }
+    for (int i {0}; i < 100; i += 2) {
+        tree.remove("APPLE"s + std::to_string(i));
+        splay.remove("APPLE"s + std::to_string(i));
+    }
+    for (int i {0}; i < 100; ++i) {
+        std::string lower {"apple"s + std::to_string(i)};
+        if (tree.contains(lower) != (i % 2 == 1) || splay.contains(lower) != (i % 2 == 1)) {return false;}
+    }
+    return isValidBST(tree) && isValidBST(splay);
+}
+
+template <int reps>
+bool testsplay() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 rng {5};
+    std::uniform_int_distribution<int> dist {0, 2 * reps};
+    sjd::BinarySearchTree<int, std::less<int>, sjd::Splay, sjd::SubtreeSizes> tree {};
+    std::set<int> reference {};
+    for (int i {0}; i < reps; ++i) {
+        int value {dist(rng)};
+        tree.insert(value);
+        reference.insert(value);
+        if (tree.root() -> value != value) {return false;}      // inserts splay too
+    }
+    for (int i {0}; i < reps / 4; ++i) {
+        int value {dist(rng)};
+        tree.remove(value);
+        reference.erase(value);
+    }
+    for (int i {0}; i < reps; ++i) {
+        int value {dist(rng)};
+        if (tree.contains(value) != reference.contains(value)) {return false;}
+        if (reference.contains(value) && tree.root() -> value != value) {return false;}
+    }
+    if (!std::ranges::equal(tree, reference) || tree.size() != reference.size()) {return false;}
+    if (*tree.select(reference.size() / 2) != *std::next(reference.begin(), static_cast<std::ptrdiff_t>(reference.size() / 2))) {return false;}
+
+    // a hot value stays at the root; const lookups don't move anything
+    int hot {*reference.begin()};
+    tree.contains(hot);
+    const auto& constTree {tree};
+    if (!constTree.contains(*reference.rbegin()) || tree.root() -> value != hot) {return false;}
+
+    return isValidBST(tree);
+}
+
+// Checks every set operation on Tree against the std::set algorithms.
+template <typename Tree, int reps>
+bool testsetoperations(int lowKey, int highKey) {
+
+    std::mt19937 rng {11};
+    std::uniform_int_distribution<int> dist {lowKey, highKey};
+    std::set<int> a {};
+    std::set<int> b {};
+    for (int i {0}; i < reps; ++i) {a.insert(dist(rng));}
+    for (int i {0}; i < reps / 10; ++i) {b.insert(dist(rng));}
+    Tree treeA {};
+    Tree treeB {};
+    for (int value : a) {treeA.insert(value);}      // sorted inserts
+    for (int value : b) {treeB.insert(value);}
+
+    std::vector<int> expected {};
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    Tree unioned {treeA};
+    if (unioned.unionWith(treeB) != expected.size() - a.size()) {return false;}
+    if (unioned.dfsInOrder() != expected || unioned.size() != expected.size()) {return false;}
+    // a small tree takes in a large one just as well
+    Tree smallFirst {treeB};
+    smallFirst.unionWith(treeA);
+    if (smallFirst.dfsInOrder() != expected) {return false;}
+
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    Tree intersected {treeA};
+    if (intersected.intersectWith(treeB) != a.size() - expected.size()) {return false;}
+    if (intersected.dfsInOrder() != expected || intersected.size() != expected.size()) {return false;}
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    Tree differenced {treeA};
+    if (differenced.differenceWith(treeB) != a.size() - expected.size()) {return false;}
+    if (differenced.dfsInOrder() != expected || differenced.size() != expected.size()) {return false;}
+    Tree empty {treeB};
+    if (empty.differenceWith(empty) != b.size() || empty.size() != 0) {return false;}
+
+    int key {(lowKey + highKey) / 2};
+    Tree lower {treeA};
+    Tree upper {lower.split(key)};
+    if (lower.size() + upper.size() != a.size()) {return false;}
+    if (!std::ranges::equal(lower, std::ranges::subrange(a.begin(), a.lower_bound(key)))) {return false;}
+    if (!std::ranges::equal(upper, std::ranges::subrange(a.lower_bound(key), a.end()))) {return false;}
+
+    return isValidBST(unioned) && isValidBST(smallFirst) && isValidBST(intersected)
+        && isValidBST(differenced) && isValidBST(lower) && isValidBST(upper);
+}
+
+// Takes anything at all in its constructor, as std::any does, so it would
+// happily be built from a wrapper around itself.
+struct Anything {
+    int key {};
+
+    Anything() = default;
+    explicit Anything(int k) : key {k} {}
+    template <typename X> requires (!std::is_same_v<std::remove_cvref_t<X>, Anything>)
+    Anything(X&&) {}
+
+    bool operator<(const Anything& other) const { return key < other.key; }
+};
+
+bool testforwardingconstructor() {
+
+    sjd::BinarySearchTree<Anything> tree {};
+    tree.insert(Anything {5});
+    const Anything three {3};
+    tree.insert(three);
+    tree.emplace(4);
+    sjd::AVLTree<Anything> avlTree {};
+    avlTree.insert(Anything {5});
+    avlTree.insert(three);
+    avlTree.emplace(4);
+    sjd::BinarySearchTree<Anything> copy {tree};
+    std::vector<Anything> values {Anything {4}, Anything {3}, Anything {5}};
+    sjd::BinarySearchTree<Anything> bulk(values.begin(), values.end());
+
+    auto keys {[](const auto& anyTree) {
+        std::vector<int> result {};
+        for (const Anything& value : anyTree) {result.push_back(value.key);}
+        return result;
+    }};
+    std::vector<int> expected {3, 4, 5};
+    return keys(tree) == expected && keys(avlTree) == expected
+        && keys(copy) == expected && keys(bulk) == expected;
+}
+
+// Sorted inserts leave a splay tree one path reps Nodes long. Splitting and
+// combining it may not recurse per level either.
+template <int reps>
+bool testdeepsetoperations() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::SplayTree<int> deep {};
+    std::vector<int> all {};
+    for (int i {0}; i < reps; ++i) {
+        deep.insert(i);
+        all.push_back(i);
+    }
+    sjd::SplayTree<int> few {};
+    std::vector<int> fewValues {};
+    for (int i {0}; i < 10; ++i) {
+        few.insert(i * (reps / 10) + 1);
+        fewValues.push_back(i * (reps / 10) + 1);
+    }
+
+    sjd::SplayTree<int> unioned {few};
+    if (unioned.unionWith(deep) != all.size() - fewValues.size() || unioned.dfsInOrder() != all) {return false;}
+    sjd::SplayTree<int> intersected {deep};
+    if (intersected.intersectWith(few) != all.size() - fewValues.size()) {return false;}
+    if (intersected.dfsInOrder() != fewValues) {return false;}
+    sjd::SplayTree<int> smallIntersected {few};
+    if (smallIntersected.intersectWith(deep) != 0 || smallIntersected.dfsInOrder() != fewValues) {return false;}
+    sjd::SplayTree<int> differenced {deep};
+    if (differenced.differenceWith(few) != fewValues.size() || differenced.size() != all.size() - fewValues.size()) {return false;}
+
+    sjd::SplayTree<int> upper {deep.split(reps / 2)};
+    return deep.size() == static_cast<std::size_t>(reps / 2)
+        && upper.size() == static_cast<std::size_t>(reps - reps / 2)
+        && *upper.begin() == reps / 2;
 }
 
 int main() {
@@ -54,6 +680,29 @@ int main() {
     std::cout << "remove 2.\n";
     myTree.remove(2);
     std::cout << myTree << "\n";
+    assert(isValidBST(myTree) && "Failed to keep the tree ordered");
+    assert(myTree.contains(140) && !myTree.contains(94) && "Failed to search correctly");
+
+    assert(testsortedinsertAVL<1000>() && "Failed to keep AVL tree balanced on insert");
+    assert(testremoveAVL<1000>() && "Failed to keep AVL tree balanced on remove");
+    assert(testcopy<100>() && "Failed to deep copy correctly");
+    assert(testmoves<100>() && "Failed to move values and trees");
+    assert(testbulkload<1000>() && "Failed to bulk load correctly");
+    assert(testiterators<1000>() && "Failed to iterate correctly");
+    assert(testcomparators() && "Failed to order with a custom comparator");
+    assert(testforwardingconstructor() && "Failed to store a value as itself");
+    assert(testorderstatistics<1000>() && "Failed to count ranks correctly");
+    assert(testdegenerate<3000>() && "Failed to walk a degenerate tree");
+    assert(testparallel<10000>() && "Failed to visit the tree in parallel");
+    assert(testfilter<5000>() && "Failed to filter misses");
+    assert(testfiltercomparators() && "Failed to keep the filter out of custom orders");
+    assert(testsplay<2000>() && "Failed to splay correctly");
+    assert((testsetoperations<sjd::SplayTree<int>, 300>(0, 600)) && "Failed to combine splay trees");
+    assert((testsetoperations<sjd::AVLTree<int>, 1000>(0, 2000)) && "Failed to combine AVL trees");
+    assert((testsetoperations<sjd::OrderStatisticTree<int>, 1000>(0, 2000)) && "Failed to combine sized trees");
+    assert((testsetoperations<sjd::BinarySearchTree<int>, 300>(0, 600)) && "Failed to combine unbalanced trees");
+    assert((testsetoperations<sjd::AVLTree<int>, 100000>(0, 1000000)) && "Failed to combine large trees");
+    assert(testdeepsetoperations<200000>() && "Failed to combine degenerate trees");
 
     std::cout << "All tests succeeded.\n";
 }
@@ -0,0 +1,263 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "../LL/compact_doubly_linked_list.h"
+#include "../LL/doubly_linked_list.h"
+
+using namespace std::string_literals;
+
+static_assert(std::bidirectional_iterator<sjd::CompactDoublyLinkedList<int>::iterator>);
+static_assert(std::bidirectional_iterator<sjd::CompactDoublyLinkedList<int>::const_iterator>);
+static_assert(std::ranges::bidirectional_range<const sjd::CompactDoublyLinkedList<int>>);
+static_assert(sizeof(sjd::CompactDoublyLinkedList<int>::Slot) == 12);
+static_assert(sizeof(sjd::CompactDoublyLinkedList<int>::Slot) * 2 <= sizeof(sjd::DoublyLinkedList<int>::Node));
+
+/*  Compact Doubly Linked List Validation function.
+ *  Walks the list both ways and checks it holds exactly the values in
+ *  reference, in order, which also checks every prev index.
+ */
+template <typename T, typename Allocator>
+bool matches(const sjd::CompactDoublyLinkedList<T, Allocator>& list, const std::list<T>& reference) {
+    if (list.length() != static_cast<int>(reference.size())) {return false;}
+    if (static_cast<std::size_t>(list.length()) > list.capacity()) {return false;}
+    return std::ranges::equal(list, reference)
+        && std::ranges::equal(list | std::views::reverse, reference | std::views::reverse);
+}
+
+// Random edits against a std::list, with strings so that growing the slab
+// has to move real objects.
+template <int reps>
+bool testagainstlist() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::CompactDoublyLinkedList list {"0"s};
+    std::list<std::string> reference {"0"s};
+    for (int i {1}; i < 4 * reps; ++i) {
+        std::string value {"value "s + std::to_string(i)};
+        int index {static_cast<int>(gen() % (reference.size() + 1))};
+        switch (gen() % 6) {
+            case 0:
+                if (!list.append(value)) {return false;}
+                reference.push_back(value);
+                break;
+            case 1:
+                if (!list.prepend(value)) {return false;}
+                reference.push_front(value);
+                break;
+            case 2:
+                if (!list.insert(index, value)) {return false;}
+                reference.insert(std::next(reference.begin(), index), value);
+                break;
+            case 3:
+                if (reference.empty()) {
+                    if (list.pop()) {return false;}
+                    break;
+                }
+                if (list.pop() != reference.back()) {return false;}
+                reference.pop_back();
+                break;
+            case 4:
+                if (reference.empty()) {
+                    if (list.popFirst()) {return false;}
+                    break;
+                }
+                if (list.popFirst() != reference.front()) {return false;}
+                reference.pop_front();
+                break;
+            default:
+                if (index == static_cast<int>(reference.size())) {
+                    if (list.remove(index)) {return false;}
+                    break;
+                }
+                auto position {std::next(reference.begin(), index)};
+                if (list.remove(index) != *position) {return false;}
+                reference.erase(position);
+        }
+        if (!matches(list, reference)) {return false;}
+    }
+    for (int i {0}; i < static_cast<int>(reference.size()); ++i) {
+        if (*list.get(i) != *std::next(reference.begin(), i)) {return false;}
+    }
+    if (list.get(-1) || list.get(list.length()) || list.insert(-1, "none"s) || list.insert(list.length() + 1, "none"s)) {return false;}
+    if (!reference.empty() && (*list.head() != reference.front() || *list.tail() != reference.back())) {return false;}
+
+    return true;
+}
+
+// Freed slots are reused before the slab grows, and growing lays the values
+// out in list order.
+template <int reps>
+bool testslab() {
+
+    static_assert(reps > 16, "You need more than one slab's worth of reps");
+    sjd::CompactDoublyLinkedList list {0};
+    std::list<int> reference {0};
+    for (int i {1}; i < reps; ++i) {
+        list.prepend(i);
+        reference.push_front(i);
+    }
+    std::size_t capacity {list.capacity()};
+    if (capacity < static_cast<std::size_t>(reps) || list.capacityBytes() != capacity * 12) {return false;}
+    for (int i {0}; i < reps / 2; ++i) {
+        list.popFirst();
+        reference.pop_front();
+    }
+    for (int i {0}; i < reps / 2; ++i) {
+        list.append(-i);
+        reference.push_back(-i);
+    }
+    if (list.capacity() != capacity || !matches(list, reference)) {return false;}
+
+    // after growing, value i lives in slot i
+    if (!list.reserve(2 * capacity) || list.capacity() != 2 * capacity || !matches(list, reference)) {return false;}
+    const char* first {reinterpret_cast<const char*>(list.head())};
+    for (int i {0}; i < list.length(); ++i) {
+        std::ptrdiff_t offset {reinterpret_cast<const char*>(list.get(i)) - first};
+        if (offset != i * static_cast<std::ptrdiff_t>(sizeof(sjd::CompactDoublyLinkedList<int>::Slot))) {return false;}
+    }
+    if (list.reserve(1) == false || list.capacity() != 2 * capacity) {return false;}
+    // no more slots than length() can count
+    std::size_t tooMany {static_cast<std::size_t>(std::numeric_limits<int>::max()) + 1};
+    if (list.reserve(tooMany) || list.capacity() != 2 * capacity) {return false;}
+
+    // a value taken from the list itself survives the slab moving under it
+    sjd::CompactDoublyLinkedList tight {"first"s};
+    for (int i {0}; i < 15; ++i) {tight.append("x"s);}
+    if (tight.capacity() != 16) {return false;}
+    tight.append(*tight.head());
+    tight.insert(1, *tight.tail());
+
+    const auto& view {tight};
+    static_assert(std::is_same_v<decltype(view.get(0)), const std::string*>, "const lists hand out const values");
+    if (view.get(1) != tight.get(1) || view.head() != tight.head() || view.tail() != tight.tail()) {return false;}
+
+    return tight.capacity() == 32 && *tight.get(1) == "first"s && *tight.tail() == "first"s;
+}
+
+// Built from an int, but refuses negative ones.
+struct Picky {
+    explicit Picky(int number) : value {number} {
+        if (number < 0) {throw std::invalid_argument {"negative"};}
+    }
+    int value;
+};
+
+// A constructor that throws leaves the slot it was building in free, so the
+// list grows exactly as one that never saw the failures.
+template <int reps>
+bool testthrowingconstructor() {
+
+    static_assert(reps > 16, "You need more than one slab's worth of reps");
+    sjd::CompactDoublyLinkedList<Picky> list {Picky{0}};
+    sjd::CompactDoublyLinkedList<Picky> twin {Picky{0}};
+    for (int i {1}; i < reps; ++i) {
+        try {
+            list.emplace_back(-i);
+            return false;
+        } catch (const std::invalid_argument&) {}
+        if (!list.emplace_back(i) || !twin.emplace_back(i)) {return false;}
+        if (list.capacity() != twin.capacity()) {return false;}
+    }
+
+    // slots on the free list survive a failed build too
+    for (int i {0}; i < reps / 2; ++i) {
+        list.popFirst();
+        twin.popFirst();
+    }
+    for (int i {0}; i < reps / 2; ++i) {
+        try {
+            list.emplace_front(-i - 1);
+            return false;
+        } catch (const std::invalid_argument&) {}
+        if (!list.emplace_front(i) || !twin.emplace_front(i)) {return false;}
+    }
+
+    return list.capacity() == twin.capacity() && list.length() == reps
+        && std::ranges::equal(list, twin, {}, &Picky::value, &Picky::value);
+}
+
+template <int reps>
+bool testcopymove() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::CompactDoublyLinkedList list {"0"s};
+    std::list<std::string> reference {"0"s};
+    for (int i {1}; i < reps; ++i) {
+        list.insert(i / 2, std::to_string(i));
+        reference.insert(std::next(reference.begin(), i / 2), std::to_string(i));
+    }
+    sjd::CompactDoublyLinkedList copy {list};
+    if (!matches(copy, reference) || copy.capacity() != static_cast<std::size_t>(reps)) {return false;}
+    copy.setValue(0, "first"s);
+    if (*list.get(0) == "first"s || list.setValue(reps, "none"s)) {return false;}
+    copy = list;
+    if (!matches(copy, reference)) {return false;}
+
+    const std::string* first {list.head()};
+    sjd::CompactDoublyLinkedList moved {std::move(list)};
+    if (moved.head() != first || list.length() != 0 || list.head() || list.capacity() != 0) {return false;}
+    list = std::move(moved);
+    swap(list, copy);
+    if (copy.head() != first || !matches(list, reference) || !matches(moved, {})) {return false;}
+    static_assert(std::is_nothrow_move_constructible_v<sjd::CompactDoublyLinkedList<std::string>>);
+    static_assert(std::is_nothrow_move_assignable_v<sjd::CompactDoublyLinkedList<std::string>>);
+
+    // an emptied list takes values again
+    while (copy.pop()) {}
+    copy.emplace_front(std::size_t {3}, 'a');
+    copy.emplace(1, "b"s);
+    copy.emplace_back("c");
+    return matches(copy, {"aaa"s, "b"s, "c"s});
+}
+
+template <int reps>
+bool testiterators() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::CompactDoublyLinkedList list {0};
+    for (int i {1}; i < reps; ++i) {
+        list.append(i);
+    }
+    for (int& value : list) {
+        value *= 2;
+    }
+    const auto& constList {list};
+    auto it {std::ranges::find(list, 2 * (reps / 2))};
+    if (it == list.end() || *it != 2 * (reps / 2)) {return false;}
+    sjd::CompactDoublyLinkedList<int>::const_iterator constIt {it};
+    if (constIt != it || std::distance(constIt, constList.cend()) != reps - reps / 2) {return false;}
+    if (*std::prev(constList.end()) != 2 * (reps - 1) || *constList.rbegin() != 2 * (reps - 1)) {return false;}
+
+    return std::ranges::is_sorted(constList) && std::ranges::is_sorted(constList | std::views::reverse, std::greater<>{});
+}
+
+int main() {
+
+    sjd::CompactDoublyLinkedList myList {3};
+    myList.append(4);
+    myList.prepend(2);
+    myList.insert(1, 5);
+    myList.printList();
+    std::cout << "\n";
+    std::cout << "Slot size: " << sizeof(decltype(myList)::Slot) << " B, DoublyLinkedList Node size: "
+              << sizeof(sjd::DoublyLinkedList<int>::Node) << " B\n";
+
+    assert(testagainstlist<500>() && "Failed to edit the list like std::list");
+    assert(testslab<1000>() && "Failed to reuse and grow the slab");
+    assert(testcopymove<100>() && "Failed to copy and move correctly");
+    assert(testiterators<100>() && "Failed to iterate correctly");
+    assert(testthrowingconstructor<100>() && "Failed to keep slots when a constructor throws");
+
+    std::cout << "All tests succeeded.\n";
+}
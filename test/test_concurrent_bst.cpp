@@ -0,0 +1,131 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../BST/concurrent_binary_search_tree.h"
+
+using namespace std::string_literals;
+
+/*  Concurrent Binary Search Tree Validation function.
+ *  Walks a snapshot to ensure every Node is correctly ordered, that cached
+ *  heights and sizes match the subtrees and that the tree is AVL balanced.
+ *  Returns the height of the subtree.
+ */
+template <typename Node>
+int validateSubtree(const Node* node, std::size_t& size) {
+    if (!node) {
+        size = 0;
+        return 0;
+    }
+    if (node -> left) {assert(node -> left -> value < node -> value && "left child out of order.");}
+    if (node -> right) {assert(node -> value < node -> right -> value && "right child out of order.");}
+    std::size_t leftSize {};
+    std::size_t rightSize {};
+    int leftHeight {validateSubtree(node -> left.get(), leftSize)};
+    int rightHeight {validateSubtree(node -> right.get(), rightSize)};
+    assert(std::abs(leftHeight - rightHeight) <= 1 && "subtree is unbalanced.");
+    assert(node -> height == 1 + std::max(leftHeight, rightHeight) && "cached height is stale.");
+    size = 1 + leftSize + rightSize;
+    assert(node -> size == size && "cached size is stale.");
+    return node -> height;
+}
+
+template <typename T>
+bool isValidSnapshot(const typename sjd::ConcurrentBinarySearchTree<T>::Snapshot& view) {
+    std::size_t size {};
+    validateSubtree(view.root(), size);
+    assert(size == view.size() && "snapshot size is stale.");
+    return true;
+}
+
+template <int reps>
+bool testsnapshotisolation() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::ConcurrentBinarySearchTree<int> tree {};
+    for (int i {0}; i < reps; ++i) {
+        tree.insert(i);
+    }
+    auto before {tree.snapshot()};
+    for (int i {0}; i < reps; i += 2) {
+        tree.remove(i);
+    }
+    tree.insert(reps);
+    auto after {tree.snapshot()};
+    if (before.size() != static_cast<std::size_t>(reps)) {return false;}
+    if (after.size() != static_cast<std::size_t>(reps / 2 + 1)) {return false;}
+    for (int i {0}; i < reps; ++i) {
+        if (!before.contains(i)) {return false;}
+        if (after.contains(i) != (i % 2 == 1)) {return false;}
+    }
+    if (before.contains(reps) || !after.contains(reps)) {return false;}
+
+    return isValidSnapshot<int>(before) && isValidSnapshot<int>(after);
+}
+
+/*  Writers insert values in pairs and then remove them in pairs while readers
+ *  keep taking snapshots. Every snapshot must be a valid tree whose size
+ *  matches its contents, whatever the writers are doing at the time.
+ */
+template <int reps>
+bool testconcurrentreaders() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::ConcurrentBinarySearchTree<int> tree {};
+    std::atomic<bool> done {false};
+    std::atomic<bool> failed {false};
+
+    std::vector<std::thread> readers {};
+    for (int r {0}; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto view {tree.snapshot()};
+                std::vector<int> values {view.dfsInOrder()};
+                if (values.size() != view.size() || !std::ranges::is_sorted(values)) {
+                    failed.store(true);
+                }
+                isValidSnapshot<int>(view);
+            }
+        });
+    }
+    std::vector<std::thread> writers {};
+    for (int w {0}; w < 2; ++w) {
+        writers.emplace_back([&tree, w] {
+            for (int i {w}; i < reps; i += 2) {tree.insert(i);}
+            for (int i {w}; i < reps; i += 4) {tree.remove(i);}
+        });
+    }
+    for (std::thread& writer : writers) {writer.join();}
+    done.store(true);
+    for (std::thread& reader : readers) {reader.join();}
+
+    for (int i {0}; i < reps; ++i) {
+        if (tree.contains(i) != (i % 4 >= 2)) {return false;}
+    }
+    return !failed.load() && isValidSnapshot<int>(tree.snapshot());
+}
+
+int main() {
+
+    sjd::ConcurrentBinarySearchTree<std::string> myStringTree {};
+    myStringTree.insert("Vermillion"s);
+    myStringTree.insert("rose-quartz"s);
+    myStringTree.insert("Purple"s);
+    auto view {myStringTree.snapshot()};
+    myStringTree.remove("Purple"s);
+    std::cout << myStringTree << "\n";
+    assert(view.contains("Purple"s) && !myStringTree.contains("Purple"s) && "Failed to isolate snapshot");
+    sjd::ConcurrentBinarySearchTree<std::string> copyStringTree {myStringTree};
+    copyStringTree.insert("Amber"s);
+    assert(!myStringTree.contains("Amber"s) && "Failed to copy correctly");
+
+    assert(testsnapshotisolation<1000>() && "Failed to isolate snapshots");
+    assert(testconcurrentreaders<2000>() && "Failed to read concurrently");
+
+    std::cout << "All tests succeeded.\n";
+}
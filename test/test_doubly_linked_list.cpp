@@ -1,7 +1,240 @@
 /*  quick test main.cpp to run tests on the libraries
  */
+#include <algorithm>
+#include <any>
+#include <cassert>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "../LL/doubly_linked_list.h"
 
+static_assert(std::bidirectional_iterator<sjd::DoublyLinkedList<int>::iterator>);
+static_assert(std::bidirectional_iterator<sjd::DoublyLinkedList<int>::const_iterator>);
+static_assert(std::ranges::bidirectional_range<const sjd::DoublyLinkedList<int>>);
+
+// Counts how often it is made, copied and moved.
+struct Counted {
+    static inline int s_constructed {0};
+    static inline int s_copied {0};
+    static inline int s_moved {0};
+
+    int value {};
+
+    Counted() { ++s_constructed; }
+    explicit Counted(int v) : value {v} { ++s_constructed; }
+    Counted(const Counted& source) : value {source.value} { ++s_copied; }
+    Counted(Counted&& source) noexcept : value {source.value} { ++s_moved; }
+    Counted& operator=(const Counted& source) { value = source.value; ++s_copied; return *this; }
+    Counted& operator=(Counted&& source) noexcept { value = source.value; ++s_moved; return *this; }
+    ~Counted() = default;
+
+    static void reset() { s_constructed = s_copied = s_moved = 0; }
+};
+
+// rvalues are moved in, emplaced values are built in their Nodes, and moving
+// or swapping whole lists never touches the values
+template <int reps>
+bool testmoves() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    Counted::reset();
+    sjd::DoublyLinkedList dll {Counted{0}};
+    for (int i {1}; i < reps; ++i) {
+        if (!dll.append(Counted{i}) || !dll.prepend(Counted{-i})) {return false;}
+    }
+    if (Counted::s_moved != 2 * reps - 1 || Counted::s_copied != 0) {return false;}
+
+    Counted::reset();
+    if (!dll.emplace(reps, 100) || !dll.emplace_back(200) || !dll.emplace_front(-200)) {return false;}
+    if (Counted::s_constructed != 3 || Counted::s_moved != 0 || Counted::s_copied != 0) {return false;}
+    if (dll.get(reps + 1) -> value.value != 100 || dll.get(reps + 1) -> prev -> value.value != 0) {return false;}
+
+    Counted::reset();
+    sjd::DoublyLinkedList moved {std::move(dll)};
+    sjd::DoublyLinkedList<Counted> assigned {Counted{7}};
+    assigned = std::move(moved);
+    swap(dll, assigned);
+    if (Counted::s_moved != 1 || Counted::s_copied != 0) {return false;}
+    if (dll.length() != 2 * reps + 2 || assigned.length() != 0 || moved.length() != 0) {return false;}
+    if (dll.head() -> value.value != -200 || dll.tail() -> value.value != 200) {return false;}
+    static_assert(std::is_nothrow_move_constructible_v<sjd::DoublyLinkedList<Counted>>);
+    static_assert(std::is_nothrow_move_assignable_v<sjd::DoublyLinkedList<Counted>>);
+
+    return std::distance(dll.begin(), dll.end()) == dll.length() && assigned.begin() == assigned.end();
+}
+
+template <int reps>
+bool testiterators() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::DoublyLinkedList dll {0};
+    for (int i {1}; i < reps; ++i) {
+        dll.append(i);
+    }
+    if (std::distance(dll.begin(), dll.end()) != dll.length()) {return false;}
+    if (*std::prev(dll.end()) != reps - 1 || *dll.rbegin() != reps - 1) {return false;}
+
+    // reversing through the iterators swaps values front to back
+    std::ranges::reverse(dll);
+    const auto& constDll {dll};
+    std::vector<int> backwards {constDll.rbegin(), constDll.rend()};
+    if (!std::ranges::is_sorted(backwards) || backwards.size() != reps) {return false;}
+    sjd::DoublyLinkedList<int>::const_iterator constIt {dll.end()};
+    if (constIt != dll.end() || *--constIt != 0) {return false;}
+
+    // taking Nodes off the ends keeps the iterators in step
+    dll.pop();
+    dll.popFirst();
+    dll.remove(dll.length() / 2);
+    return std::distance(dll.begin(), dll.end()) == reps - 3 && dll.head() -> prev == nullptr;
+}
+
+std::string listContents(const sjd::DoublyLinkedList<int>& dll) {
+    std::string contents {};
+    for (int value : dll) {
+        contents += std::to_string(value) + " ";
+    }
+    return contents;
+}
+
+// Checks the list both ways, so every prev pointer is checked as well.
+template <typename T>
+bool matches(const sjd::DoublyLinkedList<T>& dll, const std::vector<T>& reference) {
+    if (dll.length() != static_cast<int>(reference.size())) {return false;}
+    if (dll.length() == 0) {return !dll.head() && !dll.tail();}
+    if (dll.head() -> prev || dll.tail() -> next) {return false;}
+    return std::ranges::equal(dll, reference) && std::ranges::equal(dll | std::views::reverse, reference | std::views::reverse);
+}
+
+// sort(), merge(), unique() and splice() against the same steps on a vector.
+template <int reps>
+bool testsortsplice() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    using Pair = std::pair<int, int>;
+    auto byKey {[](const Pair& a, const Pair& b) { return a.first < b.first; }};
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+
+    // keys repeat, so the second value checks that the sort is stable
+    sjd::DoublyLinkedList dll {Pair{0, 0}};
+    sjd::DoublyLinkedList other {Pair{reps, -1}};
+    std::vector<Pair> reference {Pair{0, 0}};
+    std::vector<Pair> otherReference {Pair{reps, -1}};
+    for (int i {1}; i < reps; ++i) {
+        Pair value {static_cast<int>(gen() % (reps / 4 + 1)), i};
+        dll.append(value);
+        reference.push_back(value);
+        Pair otherValue {static_cast<int>(gen() % (reps / 4 + 1)), -i - 1};
+        other.prepend(otherValue);
+        otherReference.insert(otherReference.begin(), otherValue);
+    }
+    dll.sort(byKey);
+    other.sort(byKey);
+    std::ranges::stable_sort(reference, byKey);
+    std::ranges::stable_sort(otherReference, byKey);
+    if (!matches(dll, reference) || !matches(other, otherReference)) {return false;}
+
+    dll.merge(other, byKey);
+    std::vector<Pair> merged {};
+    std::ranges::merge(reference, otherReference, std::back_inserter(merged), byKey);
+    if (!matches(dll, merged) || !matches(other, {})) {return false;}
+
+    auto sameKey {[](const Pair& a, const Pair& b) { return a.first == b.first; }};
+    int removed {dll.unique(sameKey)};
+    auto last {std::ranges::unique(merged, sameKey).begin()};
+    if (removed != static_cast<int>(std::distance(last, merged.end()))) {return false;}
+    merged.erase(last, merged.end());
+    if (!matches(dll, merged)) {return false;}
+
+    // splices at the front, the middle and the end, then of an empty list
+    sjd::DoublyLinkedList front {Pair{-1, 0}};
+    sjd::DoublyLinkedList middle {Pair{-2, 0}};
+    middle.append(Pair{-3, 0});
+    sjd::DoublyLinkedList back {Pair{-4, 0}};
+    if (!dll.splice(0, front) || !dll.splice(dll.length() - 2, middle) || dll.splice(-1, back)) {return false;}
+    dll.splice(back);
+    dll.splice(back);
+    merged.insert(merged.begin(), Pair{-1, 0});
+    merged.insert(merged.end() - 2, {Pair{-2, 0}, Pair{-3, 0}});
+    merged.push_back(Pair{-4, 0});
+    if (!matches(dll, merged) || dll.splice(0, dll)) {return false;}
+    if (!matches(front, {}) || !matches(middle, {}) || !matches(back, {})) {return false;}
+    back.splice(0, dll);
+    if (!matches(dll, {}) || !matches(back, merged)) {return false;}
+
+    // sorting a list of one, or a descending list, links every Node back up
+    sjd::DoublyLinkedList countdown {3};
+    countdown.sort();
+    countdown.append(2);
+    countdown.append(1);
+    countdown.sort();
+    return matches(countdown, {1, 2, 3});
+}
+
+// compact() keeps the values, lays the Nodes out in list order and links
+// them up both ways
+template <int reps>
+bool testcompact() {
+
+    static_assert(reps > 1, "You need at least 2 reps");
+    using namespace std::string_literals;
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::DoublyLinkedList dll {"0"s};
+    std::vector<std::string> reference {"0"s};
+    for (int i {1}; i < 4 * reps; ++i) {
+        int index {static_cast<int>(gen() % (reference.size() + 1))};
+        dll.insert(index, std::to_string(i));
+        reference.insert(reference.begin() + index, std::to_string(i));
+        if (i % 2 == 0) {
+            int victim {static_cast<int>(gen() % reference.size())};
+            dll.remove(victim);
+            reference.erase(reference.begin() + victim);
+        }
+    }
+    auto stats {dll.compact()};
+    std::size_t links {reference.size() - 1};
+    if (stats.nodesMoved != reference.size() || stats.bytesMoved != reference.size() * sizeof(sjd::DoublyLinkedList<std::string>::Node)) {return false;}
+    if (stats.before.links != links || stats.after.links != links || stats.after.nearLinks <= stats.before.nearLinks) {return false;}
+    if (!matches(dll, reference) || dll.locality().nearLinks != stats.after.nearLinks) {return false;}
+
+    // the Nodes now sit in memory in list order
+    std::vector<sjd::DoublyLinkedList<std::string>::Node*> nodes {};
+    for (auto it {dll.begin()}; it != dll.end(); ++it) {
+        nodes.push_back(it.node());
+    }
+    if (!std::ranges::is_sorted(nodes) || nodes.front() != dll.head() || nodes.back() != dll.tail()) {return false;}
+
+    while (dll.length() > 0) {
+        dll.pop();
+    }
+    stats = dll.compact();
+    return stats.nodesMoved == 0 && stats.after.links == 0 && matches(dll, {});
+}
+
+// A T whose constructor takes anything, like std::any, is built from the
+// value passed in rather than from whatever the list wraps it in.
+bool testforwardingconstructor() {
+
+    sjd::DoublyLinkedList dll {std::any{1}};
+    std::any three {3};
+    dll.append(std::any{2});
+    dll.append(three);
+    dll.emplace_back(4);
+    dll.emplace_front(0);
+    dll.insert(2, std::any{5});
+    dll.compact();
+    std::vector<int> values {};
+    for (const std::any& value : dll) {
+        if (value.type() != typeid(int)) {return false;}
+        values.push_back(std::any_cast<int>(value));
+    }
+    return values == std::vector<int>{0, 1, 5, 2, 3, 4};
+}
+
 int main() {
 
 using namespace std::string_literals;
@@ -44,4 +277,12 @@ using namespace std::string_literals;
 
     myIntList.printList();
     std::cout << "\n";
+    assert(listContents(myIntList) == "11 12 13 14 " && "Failed to append and prepend correctly");
+    assert(testiterators<100>() && "Failed to iterate correctly");
+    assert(testmoves<100>() && "Failed to move values and lists");
+    assert(testsortsplice<1000>() && "Failed to sort, merge and splice correctly");
+    assert(testcompact<500>() && "Failed to compact the Nodes");
+    assert(testforwardingconstructor() && "Failed to store values whose constructor takes anything");
+
+    std::cout << "All tests succeeded.\n";
 }
@@ -0,0 +1,149 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "../BST/binary_search_tree.h"
+
+using namespace std::string_literals;
+
+/*  Frozen Set Validation function.
+ *  Checks that every slot of the Eytzinger array is greater than everything
+ *  in its left subtree and less than everything in its right subtree by
+ *  comparing each slot with its children.
+ */
+template <typename T>
+bool isValidFrozenSet(const sjd::FrozenSet<T>& set) {
+    const T* slots {set.data()};
+    for (std::size_t k {1}; k <= set.size(); ++k) {
+        if (2 * k <= set.size()) {
+            assert(slots[2 * k] < slots[k] && "left child out of order.");
+        }
+        if (2 * k + 1 <= set.size()) {
+            assert(slots[k] < slots[2 * k + 1] && "right child out of order.");
+        }
+    }
+    return true;
+}
+
+template <int reps, typename T>
+bool testagainstset() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::AVLTree<T> tree {};
+    std::set<T> reference {};
+    for (int i {0}; i < reps; ++i) {
+        T value {static_cast<T>(gen() % (4 * reps))};
+        tree.insert(value);
+        reference.insert(value);
+    }
+    sjd::FrozenSet<T> set {tree.freeze()};
+    if (set.size() != reference.size()) {return false;}
+
+    std::vector<T> queries {};
+    for (int i {0}; i < 5 * reps + 3; ++i) {
+        queries.push_back(static_cast<T>(gen() % (5 * reps)));
+    }
+    bool results[8] {};
+    for (std::size_t i {0}; i < queries.size(); ++i) {
+        T query {queries[i]};
+        if (set.contains(query) != reference.contains(query)) {return false;}
+        auto expectedBound {reference.lower_bound(query)};
+        const T* bound {set.lower_bound(query)};
+        if ((expectedBound == reference.end()) != (bound == nullptr)) {return false;}
+        if (bound && *bound != *expectedBound) {return false;}
+    }
+    for (std::size_t i {0}; i + 8 <= queries.size(); i += 8) {
+        set.containsBatch(std::span<const T>{queries.data() + i, 8}, std::span<bool>{results});
+        for (std::size_t lane {0}; lane < 8; ++lane) {
+            if (results[lane] != reference.contains(queries[i + lane])) {return false;}
+        }
+    }
+
+    return isValidFrozenSet(set);
+}
+
+static_assert(std::forward_iterator<sjd::FrozenSet<int>::const_iterator>);
+static_assert(std::ranges::forward_range<sjd::FrozenSet<int>>);
+
+template <int reps>
+bool testsaveload() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::AVLTree<std::int64_t> tree {};
+    std::set<std::int64_t> reference {};
+    for (int i {0}; i < reps; ++i) {
+        std::int64_t value {static_cast<std::int64_t>(gen() % (4 * reps))};
+        tree.insert(value);
+        reference.insert(value);
+    }
+    std::string path {(std::filesystem::temp_directory_path() / "sjd_test_frozen_set.bin").string()};
+    if (!tree.save(path)) {return false;}
+    // the header's unused bytes are written as zeros
+    std::ifstream saved {path, std::ios::binary};
+    std::vector<char> header(64);
+    saved.read(header.data(), 64);
+    if (!saved || !std::all_of(header.begin() + 32, header.end(), [](char byte) { return byte == 0; })) {return false;}
+    saved.close();
+    auto mapped {sjd::AVLTree<std::int64_t>::loadMapped(path)};
+    if (!mapped || mapped -> size() != reference.size()) {return false;}
+    if (!std::ranges::equal(*mapped, reference)) {return false;}
+    for (std::int64_t query {-1}; query <= 4 * reps; ++query) {
+        if (mapped -> contains(query) != reference.contains(query)) {return false;}
+    }
+    std::int64_t low {reps};
+    std::int64_t high {2 * reps};
+    if (!std::ranges::equal(mapped -> range(low, high),
+                            std::ranges::subrange(reference.lower_bound(low), reference.lower_bound(high)))) {
+        return false;
+    }
+
+    // files for another value size, or that are cut short, are refused
+    if (sjd::FrozenSet<std::int32_t>::loadMapped(path)) {return false;}
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    if (sjd::FrozenSet<std::int64_t>::loadMapped(path)) {return false;}
+    std::filesystem::remove(path);
+    if (sjd::FrozenSet<std::int64_t>::loadMapped(path)) {return false;}
+
+    // the empty set round trips too
+    if (!sjd::AVLTree<std::int64_t>{}.save(path)) {return false;}
+    auto empty {sjd::FrozenSet<std::int64_t>::loadMapped(path)};
+    std::filesystem::remove(path);
+    return empty && empty -> size() == 0 && empty -> begin() == empty -> end() && isValidFrozenSet(*mapped);
+}
+
+int main() {
+
+    sjd::BinarySearchTree<std::string> myStringTree {};
+    myStringTree.insert("Vermillion"s);
+    myStringTree.insert("rose-quartz"s);
+    myStringTree.insert("Purple"s);
+    myStringTree.insert("Amber"s);
+    sjd::FrozenSet<std::string> myStringSet {myStringTree.freeze()};
+    myStringTree.remove("Purple"s);
+    std::cout << myStringSet << "\n";
+    assert(myStringSet.contains("Purple"s) && "Failed to keep snapshot independent of tree");
+    assert(*myStringSet.lower_bound("B"s) == "Purple"s && "Failed to find lower bound");
+    assert(!myStringSet.lower_bound("z"s) && "Failed to report missing lower bound");
+
+    sjd::FrozenSet<int> emptySet {sjd::BinarySearchTree<int>{}.freeze()};
+    assert(!emptySet.contains(0) && !emptySet.lower_bound(0) && "Failed on empty set");
+
+    assert((testagainstset<1, int>()) && "Failed to match std::set with 1 value");
+    assert((testagainstset<1000, int>()) && "Failed to match std::set with int");
+    assert((testagainstset<1000, std::uint32_t>()) && "Failed to match std::set with uint32");
+    assert((testagainstset<1000, double>()) && "Failed to match std::set with double");
+    assert(testsaveload<1000>() && "Failed to save and map a frozen set");
+
+    std::cout << "All tests succeeded.\n";
+}
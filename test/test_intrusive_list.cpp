@@ -0,0 +1,153 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <random>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include "../LL/intrusive_list.h"
+
+// An object that can sit on two lists at once.
+struct Widget {
+    int id {};
+    sjd::IntrusiveListHook<Widget> all {};
+    sjd::IntrusiveListHook<Widget> picked {};
+
+    friend std::ostream& operator<< (std::ostream& out, const Widget& widget) {
+        return out << "Widget " << widget.id;
+    }
+};
+
+using AllList = sjd::IntrusiveList<Widget, &Widget::all>;
+using PickedList = sjd::IntrusiveList<Widget, &Widget::picked>;
+
+static_assert(std::bidirectional_iterator<AllList::iterator>);
+static_assert(std::bidirectional_iterator<AllList::const_iterator>);
+static_assert(std::ranges::bidirectional_range<const AllList>);
+
+/*  Intrusive List Validation function.
+ *  Walks the list both ways and checks it holds exactly the objects in
+ *  reference, in order, which also checks every prev link.
+ */
+template <typename List>
+bool matches(const List& list, const std::list<Widget*>& reference) {
+    if (list.length() != static_cast<int>(reference.size())) {return false;}
+    if (list.length() == 0) {return !list.head() && !list.tail();}
+    if (list.head() != reference.front() || list.tail() != reference.back()) {return false;}
+    auto address {[](const Widget& widget) { return &widget; }};
+    return std::ranges::equal(list | std::views::transform(address), reference)
+        && std::ranges::equal(list | std::views::reverse | std::views::transform(address), reference | std::views::reverse);
+}
+
+// Random links and unlinks against a std::list of pointers.
+template <int reps>
+bool testagainstlist() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    std::vector<Widget> widgets(static_cast<std::size_t>(reps));
+    for (int i {0}; i < reps; ++i) {widgets[static_cast<std::size_t>(i)].id = i;}
+    AllList list {};
+    std::list<Widget*> reference {};
+    for (int i {0}; i < 4 * reps; ++i) {
+        Widget& widget {widgets[gen() % widgets.size()]};
+        bool linked {std::ranges::find(reference, &widget) != reference.end()};
+        if (widget.all.isLinked() != linked) {return false;}
+        switch (gen() % 4) {
+            case 0:
+                if (list.append(widget) == linked) {return false;}
+                if (!linked) {reference.push_back(&widget);}
+                break;
+            case 1:
+                if (list.prepend(widget) == linked) {return false;}
+                if (!linked) {reference.push_front(&widget);}
+                break;
+            case 2:
+                if (list.remove(widget) != linked) {return false;}
+                reference.remove(&widget);
+                break;
+            default:
+                if (reference.empty()) {break;}
+                Widget* position {*std::next(reference.begin(), static_cast<long>(gen() % reference.size()))};
+                if (list.insertBefore(*position, widget) == linked) {return false;}
+                if (!linked) {reference.insert(std::ranges::find(reference, position), &widget);}
+        }
+        if (!matches(list, reference)) {return false;}
+    }
+    while (list.length() > 1) {
+        if (list.pop() != reference.back() || list.popFirst() != reference.front()) {return false;}
+        reference.pop_back();
+        reference.pop_front();
+    }
+    list.clear();
+    if (list.pop() || list.popFirst() || !matches(list, {})) {return false;}
+
+    return std::ranges::none_of(widgets, [](const Widget& widget) { return widget.all.isLinked(); });
+}
+
+// Objects on two lists at once through two hooks, unaffected by copies.
+bool testtwohooks() {
+
+    std::vector<Widget> widgets(10);
+    AllList all {};
+    PickedList picked {};
+    std::list<Widget*> allReference {};
+    std::list<Widget*> pickedReference {};
+    for (int i {0}; i < 10; ++i) {
+        Widget& widget {widgets[static_cast<std::size_t>(i)]};
+        widget.id = i;
+        all.append(widget);
+        allReference.push_back(&widget);
+        if (i % 3 == 0) {
+            picked.prepend(widget);
+            pickedReference.push_front(&widget);
+        }
+    }
+    if (!matches(all, allReference) || !matches(picked, pickedReference)) {return false;}
+
+    // taking an object off one list leaves it on the other
+    all.remove(widgets[3]);
+    allReference.remove(&widgets[3]);
+    if (!matches(all, allReference) || !matches(picked, pickedReference)) {return false;}
+    if (widgets[3].all.isLinked() || !widgets[3].picked.isLinked()) {return false;}
+
+    // copies start off on no list and assignments keep their own lists
+    Widget copy {widgets[6]};
+    if (copy.id != 6 || copy.all.isLinked() || copy.picked.isLinked()) {return false;}
+    widgets[6] = widgets[3];
+    if (widgets[6].id != 3 || !widgets[6].all.isLinked() || !matches(all, allReference)) {return false;}
+    widgets[6].id = 6;
+
+    // moves and splices hand the objects over without touching the others
+    AllList moved {std::move(all)};
+    if (!matches(all, {}) || !matches(moved, allReference)) {return false;}
+    all.append(copy);
+    all.splice(moved);
+    allReference.push_front(&copy);
+    if (!matches(all, allReference) || !matches(moved, {})) {return false;}
+    moved = std::move(all);
+    swap(all, moved);
+    if (!matches(all, allReference) || !matches(moved, {}) || !matches(picked, pickedReference)) {return false;}
+    all.remove(copy);
+
+    return std::ranges::max_element(all, {}, &Widget::id) -> id == 9;
+}
+
+int main() {
+
+    std::vector<Widget> widgets {Widget{1}, Widget{2}, Widget{3}};
+    AllList myList {};
+    myList.append(widgets[1]);
+    myList.prepend(widgets[0]);
+    myList.append(widgets[2]);
+    myList.printList();
+    std::cout << "\n";
+
+    assert(testagainstlist<200>() && "Failed to link and unlink like std::list");
+    assert(testtwohooks() && "Failed to keep objects on two lists at once");
+
+    std::cout << "All tests succeeded.\n";
+}
@@ -1,11 +1,19 @@
 /*  quick test main.cpp to run tests on the libraries
  */
 #include <algorithm>
+#include <any>
 #include <array>
 #include <cassert>
+#include <iterator>
+#include <numeric>
 #include <random>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "../LL/linked_list.h"
+#include "../LL/node_pool.h"
 
 using namespace std::string_literals;
 
@@ -13,25 +21,26 @@ using namespace std::string_literals;
  *  Tests the passed Linked List to ensure head, tail and length members are 
  *  valid and traverses the list fully to ensure the list isn't circular.
  */
-template <typename T>
-bool isValidLL(const sjd::LinkedList<T>& ll) {
+template <typename T, typename Allocator>
+bool isValidLL(const sjd::LinkedList<T, Allocator>& ll) {
     assert((ll.length() >= 0) && "length must not be a negative.");
     if (ll.length() == 0) {
         assert((
-            ll.begin() == nullptr && 
-            ll.end() == nullptr
-        ) && "begin and end must be nullptr if length is 0.");
+            ll.head() == nullptr && 
+            ll.tail() == nullptr
+        ) && "head and tail must be nullptr if length is 0.");
     }
     else {
         // traverse the ll to confirm not circular
-        auto tortoise {ll.begin()};
-        auto hare {ll.begin() -> next};
-        while (hare != ll.end() && hare != nullptr){
+        auto tortoise {ll.head()};
+        auto hare {ll.head() -> next};
+        while (hare != ll.tail() && hare != nullptr){
             assert(tortoise != hare && "Circular list. aborting");
             tortoise = tortoise -> next;
             hare = hare -> next -> next;
         }
     }
+    assert(std::distance(ll.begin(), ll.end()) == ll.length() && "iterators must visit every value.");
     return true;
 }
 
@@ -45,8 +54,8 @@ bool testappend() {
         ll.append(i);
         ++i;
     }
-    if (ll.begin() -> value != 0) {return false;}
-    if (ll.end() -> value != reps) {return false;}
+    if (ll.head() -> value != 0) {return false;}
+    if (ll.tail() -> value != reps) {return false;}
     if (ll.length() != (reps + 1)) {return false;}
 
     return isValidLL(ll);
@@ -62,8 +71,8 @@ bool testprepend() {
         ll.prepend(i);
         ++i;
     }
-    if (ll.begin() -> value != reps) {return false;}
-    if (ll.end() -> value != 0) {return false;}
+    if (ll.head() -> value != reps) {return false;}
+    if (ll.tail() -> value != 0) {return false;}
     if (ll.length() != (reps + 1)) {return false;}
 
     return isValidLL(ll);
@@ -82,7 +91,7 @@ bool testdeleteLast() {
     i = 1;
     while (i <= reps) {
         ll.deleteLast();
-        if (ll.end() -> value != (reps - i)) {return false;}
+        if (ll.tail() -> value != (reps - i)) {return false;}
         if (ll.length() != (reps - i + 1)) {return false;}
         ++i;
     }
@@ -103,7 +112,7 @@ bool testdeleteFirst() {
     i = 1;
     while (i <= reps) {
         ll.deleteFirst();
-        if (ll.begin() -> value != (i)) {return false;}
+        if (ll.head() -> value != (i)) {return false;}
         if (ll.length() != (reps - i + 1)) {return false;}
         ++i;
     }
@@ -136,6 +145,436 @@ bool testget() {
     return isValidLL(ll);
 }
 
+// Walking on from the cursor makes an in-order loop of set() linear.
+template <int reps>
+bool testcursor() {
+
+    static_assert(reps > 2, "You need at least 3 reps");
+    sjd::LinkedList ll {0};
+    std::vector<int> reference {0};
+    for (int i {1}; i < reps; ++i) {
+        ll.append(i);
+        reference.push_back(i);
+    }
+    ll.resetIndexStats();
+    for (int i {0}; i < reps; ++i) {
+        if (!ll.set(i, 2 * i)) {return false;}
+        reference[static_cast<std::size_t>(i)] = 2 * i;
+    }
+    auto stats {ll.indexStats()};
+    // one hop to each index from the one before, except from the head to
+    // index 1 and straight to the tail at the end
+    if (stats.lookups != reps || stats.hops != reps - 2 || stats.cursorStarts != reps - 3) {return false;}
+    if (stats.hopsSaved != static_cast<std::size_t>(reps * (reps - 1) / 2 - (reps - 2))) {return false;}
+
+    // const lookups only read: the stats and the cursor stay as they were
+    const sjd::LinkedList<int>& view {ll};
+    for (int i {reps - 1}; i >= 0; --i) {
+        if (view.get(i) -> value != reference[static_cast<std::size_t>(i)]) {return false;}
+    }
+    if (view.get(reps) || view.indexStats().lookups != stats.lookups) {return false;}
+
+    // the cursor follows inserts and deletes at either end and in the middle
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    for (int i {0}; i < reps; ++i) {
+        int index {static_cast<int>(gen() % reference.size())};
+        switch (gen() % 5) {
+            case 0:
+                ll.prepend(i);
+                reference.insert(reference.begin(), i);
+                break;
+            case 1:
+                ll.deleteFirst();
+                reference.erase(reference.begin());
+                break;
+            case 2:
+                ll.insert(index, i);
+                reference.insert(reference.begin() + index, i);
+                break;
+            case 3:
+                ll.deleteNode(index);
+                reference.erase(reference.begin() + index);
+                break;
+            default:
+                ll.deleteLast();
+                reference.pop_back();
+        }
+        if (reference.empty()) {
+            ll.append(i);
+            reference.push_back(i);
+        }
+        index = static_cast<int>(gen() % reference.size());
+        if (ll.get(index) -> value != reference[static_cast<std::size_t>(index)]) {return false;}
+    }
+    if (!std::ranges::equal(ll, reference)) {return false;}
+
+    return isValidLL(ll);
+}
+
+// Lookups through the skip index against a vector, as the List changes shape.
+template <int stride, int reps>
+bool testskipindex() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::LinkedList ll {0};
+    std::vector<int> reference {0};
+    ll.enableSkipIndex(stride);
+    for (int i {1}; i < reps; ++i) {
+        ll.append(i);
+        reference.push_back(i);
+    }
+    if (ll.indexStats().checkpoints != static_cast<std::size_t>((reps - 1) / stride)) {return false;}
+
+    auto checkRandomGets {[&]() {
+        ll.resetIndexStats();
+        for (int i {0}; i < reps; ++i) {
+            int index {static_cast<int>(gen() % reference.size())};
+            if (ll.get(index) -> value != reference[static_cast<std::size_t>(index)]) {return false;}
+        }
+        auto stats {ll.indexStats()};
+        return stats.hops <= stats.lookups * (2 * stride - 1);
+    }};
+    if (!checkRandomGets()) {return false;}
+
+    for (int i {0}; i < 4 * reps; ++i) {
+        int index {static_cast<int>(gen() % (reference.size() + 1))};
+        switch (gen() % 6) {
+            case 0:
+                ll.prepend(-i);
+                reference.insert(reference.begin(), -i);
+                break;
+            case 1:
+                ll.append(-i);
+                reference.push_back(-i);
+                break;
+            case 2:
+            case 3:
+                ll.insert(index, -i);
+                reference.insert(reference.begin() + index, -i);
+                break;
+            case 4:
+                if (index == static_cast<int>(reference.size())) {
+                    ll.deleteLast();
+                    reference.pop_back();
+                }
+                else {
+                    ll.deleteNode(index);
+                    reference.erase(reference.begin() + index);
+                }
+                break;
+            default:
+                ll.deleteFirst();
+                reference.erase(reference.begin());
+        }
+        if (reference.empty()) {
+            ll.append(i);
+            reference.push_back(i);
+        }
+        index = static_cast<int>(gen() % reference.size());
+        if (ll.get(index) -> value != reference[static_cast<std::size_t>(index)]) {return false;}
+    }
+    if (!std::ranges::equal(ll, reference) || !checkRandomGets()) {return false;}
+
+    // a const List reads through the checkpoints without counting anything
+    const sjd::LinkedList<int>& view {ll};
+    std::size_t lookups {view.indexStats().lookups};
+    for (int i {0}; i < static_cast<int>(reference.size()); ++i) {
+        if (view.get(i) -> value != reference[static_cast<std::size_t>(i)]) {return false;}
+    }
+    if (view.indexStats().lookups != lookups) {return false;}
+
+    // whole-List changes leave the index to be rebuilt on the next lookup
+    ll.sort();
+    std::ranges::sort(reference);
+    if (!checkRandomGets()) {return false;}
+    ll.reverse();
+    std::ranges::reverse(reference);
+    sjd::LinkedList extra {1};
+    extra.append(2);
+    ll.splice(3, extra);
+    reference.insert(reference.begin() + 3, {1, 2});
+    if (!checkRandomGets()) {return false;}
+
+    sjd::LinkedList copy {ll};
+    if (copy.indexStats().checkpoints == 0 || copy.get(reps / 2) -> value != reference[reps / 2]) {return false;}
+    copy.disableSkipIndex();
+    if (copy.indexStats().checkpoints != 0 || copy.get(reps / 2) -> value != reference[reps / 2]) {return false;}
+
+    return isValidLL(ll) && isValidLL(copy);
+}
+
+template <int reps>
+bool testdeleteNode() {
+
+    static_assert(reps > 2, "You need at least 3 reps");
+    sjd::LinkedList ll {0};
+    for (int i {1}; i < reps; ++i) {
+        ll.append(i);
+    }
+    ll.deleteNode(reps - 1);
+    ll.deleteNode(1);
+    ll.deleteNode(0);
+    if (ll.length() != reps - 3) {return false;}
+    if (ll.head() -> value != 2 || ll.tail() -> value != reps - 2) {return false;}
+
+    return isValidLL(ll);
+}
+
+template <int reps>
+bool testpool() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    using List = sjd::LinkedList<int, sjd::PoolAllocator<int>>;
+    sjd::NodePool& pool {sjd::PoolAllocator<List::Node>::pool()};
+    {
+        List ll {0};
+        for (int i {1}; i <= reps; ++i) {
+            ll.append(i);
+        }
+        if (pool.size() != reps + 1) {return false;}
+
+        // freed Nodes are reused before the pool grows
+        std::size_t capacity {pool.capacityBytes()};
+        for (int i {0}; i < reps; ++i) {
+            ll.deleteFirst();
+            ll.append(i);
+        }
+        if (pool.capacityBytes() != capacity || pool.size() != reps + 1) {return false;}
+
+        List copy {ll};
+        copy = ll;
+        if (pool.size() != 2 * (reps + 1) || copy.tail() -> value != ll.tail() -> value) {return false;}
+        if (pool.release()) {return false;}     // Nodes are still alive
+        if (!isValidLL(ll) || !isValidLL(copy)) {return false;}
+
+        // allocators share a pool only with others from the same thread
+        sjd::PoolAllocator<int> local {};
+        sjd::PoolAllocator<int> remote {};
+        std::thread {[&remote]() { remote = sjd::PoolAllocator<int>{}; }}.join();
+        if (local != ll.get_allocator() || local != copy.get_allocator() || local == remote) {return false;}
+
+        List moved {-1};
+        moved = std::move(copy);
+        if (pool.size() != 2 * (reps + 1) || moved.length() != reps + 1 || copy.length() != 0) {return false;}
+    }
+    return pool.size() == 0 && pool.release() && pool.capacityBytes() == 0;
+}
+
+// sort(), merge(), unique() and splice() against the same steps on a vector.
+// A pooled List shows that none of them allocates.
+template <int reps>
+bool testsortsplice() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    using Pair = std::pair<int, int>;
+    using List = sjd::LinkedList<Pair, sjd::PoolAllocator<Pair>>;
+    sjd::NodePool& pool {sjd::PoolAllocator<List::Node>::pool()};
+    auto byKey {[](const Pair& a, const Pair& b) { return a.first < b.first; }};
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+
+    // keys repeat, so the second value checks that the sort is stable
+    List ll {Pair{0, 0}};
+    std::vector<Pair> reference {Pair{0, 0}};
+    for (int i {1}; i < reps; ++i) {
+        Pair value {static_cast<int>(gen() % (reps / 4 + 1)), i};
+        ll.append(value);
+        reference.push_back(value);
+    }
+    std::size_t live {pool.size()};
+    std::size_t capacity {pool.capacityBytes()};
+    ll.sort(byKey);
+    std::ranges::stable_sort(reference, byKey);
+    if (!std::ranges::equal(ll, reference) || !isValidLL(ll)) {return false;}
+    if (ll.tail() -> value != reference.back()) {return false;}
+    if (pool.size() != live || pool.capacityBytes() != capacity) {return false;}
+
+    List other {Pair{reps, -1}};
+    for (int i {1}; i < reps; ++i) {
+        other.prepend(Pair{static_cast<int>(gen() % (reps / 4 + 1)), -i - 1});
+    }
+    std::vector<Pair> otherReference {other.begin(), other.end()};
+    live = pool.size();
+    capacity = pool.capacityBytes();
+    other.sort(byKey);
+    std::ranges::stable_sort(otherReference, byKey);
+    ll.merge(other, byKey);
+    std::vector<Pair> merged {};
+    std::ranges::merge(reference, otherReference, std::back_inserter(merged), byKey);
+    if (!std::ranges::equal(ll, merged) || other.length() != 0 || !isValidLL(ll) || !isValidLL(other)) {return false;}
+    if (ll.tail() -> value != Pair{reps, -1}) {return false;}
+
+    auto sameKey {[](const Pair& a, const Pair& b) { return a.first == b.first; }};
+    int removed {ll.unique(sameKey)};
+    auto last {std::ranges::unique(merged, sameKey).begin()};
+    if (removed != static_cast<int>(std::distance(last, merged.end()))) {return false;}
+    merged.erase(last, merged.end());
+    if (!std::ranges::equal(ll, merged) || !isValidLL(ll)) {return false;}
+    if (pool.size() != live - static_cast<std::size_t>(removed) || pool.capacityBytes() != capacity) {return false;}
+
+    // splices at the front, the middle and the end, then of an empty List
+    std::vector<Pair> spliced {ll.begin(), ll.end()};
+    List front {Pair{-1, 0}};
+    List middle {Pair{-2, 0}};
+    middle.append(Pair{-3, 0});
+    List back {Pair{-4, 0}};
+    if (!ll.splice(0, front) || !ll.splice(3, middle) || ll.splice(ll.length() + 1, back)) {return false;}
+    ll.splice(back);
+    spliced.insert(spliced.begin(), Pair{-1, 0});
+    spliced.insert(spliced.begin() + 3, {Pair{-2, 0}, Pair{-3, 0}});
+    spliced.push_back(Pair{-4, 0});
+    ll.splice(back);
+    if (!std::ranges::equal(ll, spliced) || ll.splice(0, ll)) {return false;}
+    if (front.length() != 0 || middle.length() != 0 || back.length() != 0) {return false;}
+    if (!isValidLL(front) || !isValidLL(middle) || !isValidLL(back)) {return false;}
+    back.splice(ll);
+    if (ll.length() != 0 || back.tail() -> value != Pair{-4, 0} || back.length() != static_cast<int>(spliced.size())) {return false;}
+
+    return isValidLL(ll) && isValidLL(back);
+}
+
+// Counts how often it is made, copied and moved.
+struct Counted {
+    static inline int s_constructed {0};
+    static inline int s_copied {0};
+    static inline int s_moved {0};
+
+    int value {};
+
+    Counted() { ++s_constructed; }
+    explicit Counted(int v) : value {v} { ++s_constructed; }
+    Counted(const Counted& source) : value {source.value} { ++s_copied; }
+    Counted(Counted&& source) noexcept : value {source.value} { ++s_moved; }
+    Counted& operator=(const Counted& source) { value = source.value; ++s_copied; return *this; }
+    Counted& operator=(Counted&& source) noexcept { value = source.value; ++s_moved; return *this; }
+    ~Counted() = default;
+
+    static void reset() { s_constructed = s_copied = s_moved = 0; }
+};
+
+// rvalues are moved in, emplaced values are built in their Nodes, and moving
+// or swapping whole lists never touches the values
+template <int reps>
+bool testmoves() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    Counted::reset();
+    sjd::LinkedList ll {Counted{0}};
+    for (int i {1}; i < reps; ++i) {
+        ll.append(Counted{i});
+    }
+    if (Counted::s_moved != reps || Counted::s_copied != 0) {return false;}
+
+    Counted::reset();
+    ll.emplace_back(reps);
+    ll.emplace_front(-1);
+    if (!ll.emplace(1, -2) || ll.emplace(reps + 4, 0)) {return false;}
+    if (Counted::s_constructed != 3 || Counted::s_moved != 0 || Counted::s_copied != 0) {return false;}
+    if (ll.get(1) -> value.value != -2 || ll.tail() -> value.value != reps) {return false;}
+
+    Counted::reset();
+    sjd::LinkedList moved {std::move(ll)};
+    sjd::LinkedList<Counted> assigned {Counted{7}};
+    assigned = std::move(moved);
+    Counted extra {8};
+    ll.append(extra);
+    swap(ll, assigned);
+    if (Counted::s_moved != 1 || Counted::s_copied != 1) {return false;}
+    if (ll.length() != reps + 3 || assigned.length() != 1 || moved.length() != 0) {return false;}
+    if (ll.head() -> value.value != -1 || assigned.head() -> value.value != 8) {return false;}
+    static_assert(std::is_nothrow_move_constructible_v<sjd::LinkedList<Counted>>);
+    static_assert(std::is_nothrow_move_assignable_v<sjd::LinkedList<Counted>>);
+
+    return isValidLL(ll) && isValidLL(moved) && isValidLL(assigned);
+}
+
+static_assert(std::forward_iterator<sjd::LinkedList<int>::iterator>);
+static_assert(std::forward_iterator<sjd::LinkedList<int>::const_iterator>);
+static_assert(std::ranges::forward_range<const sjd::LinkedList<int>>);
+
+template <int reps>
+bool testiterators() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::LinkedList ll {0};
+    for (int i {1}; i < reps; ++i) {
+        ll.append(i);
+    }
+    for (int& value : ll) {
+        value *= 2;
+    }
+    const auto& constLl {ll};
+    if (std::accumulate(constLl.begin(), constLl.end(), 0) != reps * (reps - 1)) {return false;}
+    if (!std::ranges::is_sorted(ll) || std::ranges::count_if(ll, [](int v) { return v % 4 == 0; }) != (reps + 1) / 2) {return false;}
+
+    // algorithms write through iterators, and iterators convert to const ones
+    std::ranges::fill(std::ranges::find(ll, 2 * (reps / 2)), ll.end(), -1);
+    sjd::LinkedList<int>::const_iterator constIt {ll.begin()};
+    if (constIt != ll.begin() || std::ranges::count(constLl, -1) != reps - reps / 2) {return false;}
+    if (ll.tail() -> value != -1 || std::next(ll.begin(), 2).node() != ll.get(2)) {return false;}
+
+    return isValidLL(ll);
+}
+
+// compact() keeps the values, lays the Nodes out in list order and leaves
+// lookups working
+template <int reps>
+bool testcompact() {
+
+    static_assert(reps > 1, "You need at least 2 reps");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::LinkedList ll {"0"s};
+    std::vector<std::string> reference {"0"s};
+    ll.enableSkipIndex(8);
+    for (int i {1}; i < 4 * reps; ++i) {
+        int index {static_cast<int>(gen() % (reference.size() + 1))};
+        ll.insert(index, std::to_string(i));
+        reference.insert(reference.begin() + index, std::to_string(i));
+        if (i % 2 == 0) {
+            int victim {static_cast<int>(gen() % reference.size())};
+            ll.deleteNode(victim);
+            reference.erase(reference.begin() + victim);
+        }
+    }
+    auto stats {ll.compact()};
+    std::size_t links {reference.size() - 1};
+    if (stats.nodesMoved != reference.size() || stats.bytesMoved != reference.size() * sizeof(sjd::LinkedList<std::string>::Node)) {return false;}
+    if (stats.before.links != links || stats.after.links != links || stats.after.nearLinks <= stats.before.nearLinks) {return false;}
+    if (!std::ranges::equal(ll, reference) || ll.locality().nearLinks != stats.after.nearLinks) {return false;}
+
+    // the Nodes now sit in memory in list order
+    std::vector<sjd::LinkedList<std::string>::Node*> nodes {};
+    for (auto it {ll.begin()}; it != ll.end(); ++it) nodes.push_back(it.node());
+    if (!std::ranges::is_sorted(nodes) || nodes.back() != ll.tail()) {return false;}
+    for (int i {0}; i < ll.length(); ++i) {
+        if (ll.get(i) -> value != reference[static_cast<std::size_t>(i)]) {return false;}
+    }
+
+    while (ll.length() > 0) ll.deleteFirst();
+    stats = ll.compact();
+    return stats.nodesMoved == 0 && stats.after.links == 0 && isValidLL(ll);
+}
+
+// A T whose constructor takes anything, like std::any, is built from the
+// value passed in rather than from whatever the List wraps it in.
+bool testforwardingconstructor() {
+
+    sjd::LinkedList ll {std::any{1}};
+    std::any three {3};
+    ll.append(std::any{2});
+    ll.append(three);
+    ll.emplace_back(4);
+    ll.emplace_front(0);
+    ll.insert(2, std::any{5});
+    ll.compact();
+    std::vector<int> values {};
+    for (const std::any& value : ll) {
+        if (value.type() != typeid(int)) {return false;}
+        values.push_back(std::any_cast<int>(value));
+    }
+    return values == std::vector<int>{0, 1, 5, 2, 3, 4} && isValidLL(ll);
+}
+
 int main() {
 
     sjd::LinkedList myStringList { "first_string"s };
@@ -162,6 +601,16 @@ int main() {
     assert(testdeleteLast<4>() && "Failed to deleteLast correctly");
     assert(testdeleteFirst<4>() && "Failed to deleteFirst correctly");
     assert(testget<20>() && "Failed to get correctly");
+    assert(testcursor<1000>() && "Failed to walk on from the cursor");
+    assert((testskipindex<1, 300>()) && "Failed to look up through a dense skip index");
+    assert((testskipindex<8, 2000>()) && "Failed to look up through the skip index");
+    assert(testdeleteNode<10>() && "Failed to deleteNode correctly");
+    assert(testpool<1000>() && "Failed to allocate from a pool");
+    assert(testiterators<100>() && "Failed to iterate correctly");
+    assert(testmoves<100>() && "Failed to move values and lists");
+    assert(testsortsplice<1000>() && "Failed to sort, merge and splice correctly");
+    assert(testcompact<500>() && "Failed to compact the Nodes");
+    assert(testforwardingconstructor() && "Failed to store values whose constructor takes anything");
 
     std::cout << "All tests succeeded.\n";
 }
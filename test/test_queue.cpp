@@ -1,5 +1,15 @@
+#include <algorithm>
+#include <any>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
 #include "../LL/queue.h"
 
+static_assert(std::forward_iterator<sjd::Queue<int>::iterator>);
+static_assert(std::ranges::forward_range<const sjd::Queue<int>>);
+
 int main() {
 
     using namespace std::string_literals;
@@ -22,4 +32,40 @@ int main() {
     sjd::Queue<int> myIntQueue {};
     myIntQueue.printQueue();
     std::cout << "\n";
+    assert(myIntQueue.begin() == myIntQueue.end() && !myIntQueue.dequeue() && "Failed to stay empty");
+
+    // iterators run from the front of the queue to the back
+    for (int i {0}; i < 10; ++i) {
+        myIntQueue.enqueue(i);
+    }
+    myIntQueue.dequeue();
+    for (int& value : myIntQueue) {
+        value *= 10;
+    }
+    assert(std::ranges::is_sorted(myIntQueue) && *myIntQueue.begin() == 10 && "Failed to iterate front to back");
+    assert(std::distance(myIntQueue.cbegin(), myIntQueue.cend()) == myIntQueue.length() && "Failed to iterate every value");
+
+    // move-only values go in by move or emplace, and whole queues move
+    sjd::Queue<std::unique_ptr<int>> ownerQueue {};
+    ownerQueue.enqueue(std::make_unique<int>(1));
+    ownerQueue.emplace(new int {2});
+    sjd::Queue<std::unique_ptr<int>> movedQueue {std::move(ownerQueue)};
+    assert(ownerQueue.length() == 0 && movedQueue.length() == 2 && "Failed to move a queue");
+    ownerQueue = std::move(movedQueue);
+    swap(ownerQueue, movedQueue);
+    assert(*movedQueue.dequeue() -> value == 1 && *movedQueue.dequeue() -> value == 2 && "Failed to keep the order after moves");
+    assert(ownerQueue.begin() == ownerQueue.end() && "Failed to swap queues");
+
+    // a value whose constructor takes anything is stored as itself
+    sjd::Queue<std::any> anyQueue {};
+    std::any two {2};
+    anyQueue.enqueue(std::any{1});
+    anyQueue.enqueue(two);
+    anyQueue.emplace(3);
+    for (int i {1}; i <= 3; ++i) {
+        auto node {anyQueue.dequeue()};
+        assert(node -> value.type() == typeid(int) && std::any_cast<int>(node -> value) == i && "Failed to store a std::any as itself");
+    }
+
+    std::cout << "All tests succeeded.\n";
 }
@@ -1,6 +1,39 @@
+#include <algorithm>
+#include <any>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <string>
+#include <utility>
 #include "../LL/stack.h"
 
+static_assert(std::forward_iterator<sjd::Stack<int>::iterator>);
+static_assert(std::ranges::forward_range<const sjd::Stack<int>>);
+
+// Hands out as many Nodes as its shared budget allows, then runs out of memory.
+template <typename T>
+struct LimitedAllocator {
+    using value_type = T;
+
+    LimitedAllocator() = default;
+
+    template <typename U>
+    LimitedAllocator(const LimitedAllocator<U>& other) : budget {other.budget} {}
+
+    T* allocate(std::size_t count) {
+        if (*budget == 0) {throw std::bad_alloc {};}
+        --*budget;
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* object, std::size_t count) { std::allocator<T>{}.deallocate(object, count); }
+
+    friend bool operator==(const LimitedAllocator& a, const LimitedAllocator& b) { return a.budget == b.budget; }
+
+    std::shared_ptr<int> budget {std::make_shared<int>(0)};
+};
+
 int main() {
 
     using namespace std::string_literals;
@@ -24,4 +57,47 @@ int main() {
     myIntStack.printStack();
     std::cout << "\n";
 
+    // iterators run from the top of the stack to the bottom
+    for (int i {1}; i <= 5; ++i) {
+        myIntStack.push(i * 10);
+    }
+    assert(*myIntStack.begin() == 50 && *std::ranges::max_element(myIntStack) == 50 && "Failed to iterate top first");
+    assert(std::distance(myIntStack.begin(), myIntStack.end()) == myIntStack.length() && "Failed to iterate every value");
+    while (myIntStack.pop()) {}
+    assert(myIntStack.begin() == myIntStack.end() && myIntStack.length() == 0 && "Failed to pop everything");
+
+    // move-only values go in by move or emplace, and whole stacks move
+    sjd::Stack ownerStack {std::make_unique<int>(1)};
+    ownerStack.push(std::make_unique<int>(2));
+    ownerStack.emplace(new int {3});
+    sjd::Stack movedStack {std::move(ownerStack)};
+    assert(ownerStack.length() == 0 && movedStack.length() == 3 && "Failed to move a stack");
+    ownerStack = std::move(movedStack);
+    swap(ownerStack, movedStack);
+    assert(*movedStack.pop() -> value == 3 && *movedStack.top() -> value == 2 && "Failed to keep the order after moves");
+    assert(ownerStack.begin() == ownerStack.end() && "Failed to swap stacks");
+
+    // a value whose constructor takes anything is stored as itself
+    sjd::Stack anyStack {std::any{3}};
+    std::any two {2};
+    anyStack.push(two);
+    anyStack.emplace(1);
+    for (int i {1}; i <= 3; ++i) {
+        auto node {anyStack.pop()};
+        assert(node -> value.type() == typeid(int) && std::any_cast<int>(node -> value) == i && "Failed to store a std::any as itself");
+    }
+
+    // running out of memory is reported rather than thrown
+    LimitedAllocator<int> limited {};
+    *limited.budget = 2;
+    sjd::Stack<int, LimitedAllocator<int>> limitedStack {1, limited};
+    assert(limitedStack.push(2) && !limitedStack.push(3) && !limitedStack.emplace(3) && "Failed to report a full allocator");
+    assert(limitedStack.length() == 2 && limitedStack.top() -> value == 2 && "Failed to keep the stack after running out");
+    *limited.budget = 1;
+    sjd::Stack<int, LimitedAllocator<int>> limitedCopy {limitedStack};
+    sjd::Stack<int, LimitedAllocator<int>> emptyStack {1, limited};
+    assert(limitedCopy.length() == 1 && limitedCopy.top() -> value == 2 && "Failed to stop a copy that ran out");
+    assert(emptyStack.length() == 0 && !emptyStack.top() && "Failed to construct an empty stack when out of memory");
+
+    std::cout << "All tests succeeded.\n";
 }
@@ -0,0 +1,282 @@
+/*  quick test main.cpp to run tests on the libraries
+ */
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../LL/unrolled_linked_list.h"
+
+using namespace std::string_literals;
+
+/*  Unrolled Linked List Validation function.
+ *  Walks the Nodes to check that none is empty or overfull, that the tail is
+ *  the last Node and that the counts add up to the length.
+ */
+template <typename T, std::size_t N, typename Allocator>
+bool isValidULL(const sjd::UnrolledLinkedList<T, N, Allocator>& ull) {
+    assert((ull.length() >= 0) && "length must not be a negative.");
+    if (ull.length() == 0) {
+        assert((
+            ull.head() == nullptr &&
+            ull.tail() == nullptr
+        ) && "head and tail must be nullptr if length is 0.");
+        return true;
+    }
+    std::size_t total {0};
+    auto last {ull.head()};
+    for (auto node {ull.head()}; node; node = node -> next) {
+        assert(node -> count > 0 && "Nodes must not be empty.");
+        assert(node -> count <= N && "Nodes must not be overfull.");
+        total += node -> count;
+        last = node;
+    }
+    assert(last == ull.tail() && "tail must be the last Node.");
+    assert(total == static_cast<std::size_t>(ull.length()) && "Node counts must add up to length.");
+    assert(std::distance(ull.begin(), ull.end()) == ull.length() && "iterators must visit every value.");
+    return true;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+bool matches(const sjd::UnrolledLinkedList<T, N, Allocator>& ull, const std::vector<T>& reference) {
+    return ull.length() == static_cast<int>(reference.size()) && std::ranges::equal(ull, reference);
+}
+
+template <int reps>
+bool testappendprepend() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::UnrolledLinkedList ull {0};
+    std::vector<int> reference {0};
+    for (int i {1}; i <= reps; ++i) {
+        ull.append(i);
+        ull.prepend(-i);
+        reference.push_back(i);
+        reference.insert(reference.begin(), -i);
+    }
+    if (*ull.get(0) != -reps || *ull.get(2 * reps) != reps) {return false;}
+    if (ull.get(-1) || ull.get(2 * reps + 1)) {return false;}
+    const auto& view {ull};
+    static_assert(std::is_same_v<decltype(view.get(0)), const int*>, "const Lists hand out const values");
+    if (view.get(reps) != ull.get(reps) || *view.get(reps) != 0) {return false;}
+    if (!matches(ull, reference)) {return false;}
+
+    return isValidULL(ull);
+}
+
+// Random inserts and deletes split and merge Nodes; checks against a vector.
+template <std::size_t N, int reps>
+bool testsplitmerge() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+    sjd::UnrolledLinkedList<int, N> ull {0};
+    std::vector<int> reference {0};
+    for (int i {0}; i < reps; ++i) {
+        int index {static_cast<int>(gen() % (reference.size() + 1))};
+        if (!ull.insert(index, i)) {return false;}
+        reference.insert(reference.begin() + index, i);
+        if (i % 3 == 0) {
+            int victim {static_cast<int>(gen() % reference.size())};
+            ull.deleteNode(victim);
+            reference.erase(reference.begin() + victim);
+        }
+    }
+    if (!matches(ull, reference) || !isValidULL(ull)) {return false;}
+
+    // deleting most of the list merges Nodes back together
+    while (reference.size() > 10) {
+        int victim {static_cast<int>(gen() % reference.size())};
+        ull.deleteNode(victim);
+        reference.erase(reference.begin() + victim);
+    }
+    int nodes {0};
+    for (auto node {ull.head()}; node; node = node -> next) {++nodes;}
+    if (nodes > static_cast<int>(10 / (N / 2 == 0 ? 1 : N / 2)) + 1) {return false;}
+    if (!matches(ull, reference)) {return false;}
+
+    ull.deleteFirst();
+    ull.deleteLast();
+    reference.erase(reference.begin());
+    reference.pop_back();
+    if (!matches(ull, reference)) {return false;}
+    while (ull.length() > 0) {ull.deleteLast();}
+    if (ull.insert(1, 5) || !ull.insert(0, 5) || *ull.get(0) != 5) {return false;}
+
+    return isValidULL(ull);
+}
+
+template <int reps>
+bool testcopyreverse() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::UnrolledLinkedList ull {"0"s};
+    std::vector<std::string> reference {"0"s};
+    for (int i {1}; i < reps; ++i) {
+        ull.insert(i / 2, std::to_string(i));
+        reference.insert(reference.begin() + i / 2, std::to_string(i));
+    }
+    sjd::UnrolledLinkedList copy {ull};
+    ull.reverse();
+    std::vector<std::string> reversed {reference.rbegin(), reference.rend()};
+    if (!matches(ull, reversed) || !matches(copy, reference)) {return false;}
+    copy = ull;
+    if (!copy.set(0, "first"s) || copy.set(reps, "none"s) || *copy.get(0) != "first"s) {return false;}
+    if (*ull.get(0) != reversed.front()) {return false;}
+
+    return isValidULL(ull) && isValidULL(copy);
+}
+
+// Counts how often it is made, copied and moved.
+struct Counted {
+    static inline int s_constructed {0};
+    static inline int s_copied {0};
+    static inline int s_moved {0};
+
+    int value {};
+
+    Counted() { ++s_constructed; }
+    explicit Counted(int v) : value {v} { ++s_constructed; }
+    Counted(const Counted& source) : value {source.value} { ++s_copied; }
+    Counted(Counted&& source) noexcept : value {source.value} { ++s_moved; }
+    Counted& operator=(const Counted& source) { value = source.value; ++s_copied; return *this; }
+    Counted& operator=(Counted&& source) noexcept { value = source.value; ++s_moved; return *this; }
+    ~Counted() = default;
+
+    static void reset() { s_constructed = s_copied = s_moved = 0; }
+};
+
+// rvalues are moved into their slots, and moving or swapping whole lists
+// never touches the values
+template <int reps>
+bool testmoves() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    Counted::reset();
+    sjd::UnrolledLinkedList<Counted, 4> ull {Counted{0}};
+    for (int i {1}; i < reps; ++i) {
+        ull.append(Counted{i});
+    }
+    if (Counted::s_moved != reps || Counted::s_copied != 0) {return false;}
+
+    Counted::reset();
+    sjd::UnrolledLinkedList moved {std::move(ull)};
+    sjd::UnrolledLinkedList<Counted, 4> assigned {Counted{-1}};
+    assigned = std::move(moved);
+    swap(ull, assigned);
+    if (Counted::s_moved != 1 || Counted::s_copied != 0) {return false;}
+    if (ull.length() != reps || assigned.length() != 0 || moved.length() != 0) {return false;}
+    if (ull.get(reps - 1) -> value != reps - 1) {return false;}
+    static_assert(std::is_nothrow_move_constructible_v<sjd::UnrolledLinkedList<Counted>>);
+    static_assert(std::is_nothrow_move_assignable_v<sjd::UnrolledLinkedList<Counted>>);
+
+    return isValidULL(ull) && isValidULL(moved) && isValidULL(assigned);
+}
+
+// No default constructor and no assignment, only construction, and a count
+// of the instances alive so that no slot keeps a stale value.
+struct Sealed {
+    const int value;
+    inline static int s_live {0};
+
+    explicit Sealed(int v) : value {v} { ++s_live; }
+    Sealed(const Sealed& source) : value {source.value} { ++s_live; }
+    Sealed(Sealed&& source) noexcept : value {source.value} { ++s_live; }
+    Sealed& operator=(const Sealed&) = delete;
+    ~Sealed() { --s_live; }
+};
+
+// Values live in raw slots: only the ones in the List are ever constructed.
+template <int reps>
+bool testrawslots() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    static_assert(!std::is_default_constructible_v<Sealed>);
+    {
+        std::mt19937 gen {static_cast<std::mt19937::result_type>(reps)};
+        sjd::UnrolledLinkedList<Sealed, 4> ull {Sealed{0}};
+        std::vector<int> reference {0};
+        for (int i {1}; i < reps; ++i) {
+            int index {static_cast<int>(gen() % (reference.size() + 1))};
+            switch (gen() % 4) {
+                case 0:
+                    ull.prepend(Sealed{i});
+                    reference.insert(reference.begin(), i);
+                    break;
+                case 1:
+                    ull.insert(index, Sealed{i});
+                    reference.insert(reference.begin() + index, i);
+                    break;
+                case 2:
+                    ull.append(*ull.get(0));
+                    reference.push_back(reference.front());
+                    break;
+                default:
+                    if (reference.size() > 1) {
+                        index = static_cast<int>(gen() % reference.size());
+                        ull.deleteNode(index);
+                        reference.erase(reference.begin() + index);
+                    }
+            }
+            if (Sealed::s_live != ull.length()) {return false;}
+        }
+        ull.reverse();
+        std::ranges::reverse(reference);
+        sjd::UnrolledLinkedList copy {ull};
+        if (!std::ranges::equal(copy, reference, {}, &Sealed::value)) {return false;}
+        if (Sealed::s_live != 2 * ull.length() || !isValidULL(ull) || !isValidULL(copy)) {return false;}
+    }
+    return Sealed::s_live == 0;
+}
+
+static_assert(std::forward_iterator<sjd::UnrolledLinkedList<int>::iterator>);
+static_assert(std::forward_iterator<sjd::UnrolledLinkedList<int>::const_iterator>);
+static_assert(std::ranges::forward_range<const sjd::UnrolledLinkedList<int>>);
+
+template <int reps>
+bool testiterators() {
+
+    static_assert(reps > 0, "You need at least 1 rep");
+    sjd::UnrolledLinkedList<int, 4> ull {0};
+    for (int i {1}; i < reps; ++i) {
+        ull.append(i);
+    }
+    for (int& value : ull) {
+        value *= 2;
+    }
+    const auto& constUll {ull};
+    if (std::accumulate(constUll.begin(), constUll.end(), 0) != reps * (reps - 1)) {return false;}
+    auto it {std::ranges::find(ull, 2 * (reps / 2))};
+    if (it == ull.end() || *it != 2 * (reps / 2)) {return false;}
+    sjd::UnrolledLinkedList<int, 4>::const_iterator constIt {it};
+    if (constIt != it || std::distance(constIt, constUll.cend()) != reps - reps / 2) {return false;}
+
+    return isValidULL(ull);
+}
+
+int main() {
+
+    sjd::UnrolledLinkedList myIntList {3};
+    myIntList.append(4);
+    myIntList.prepend(2);
+    myIntList.set(0, 1);
+    myIntList.printList();
+    std::cout << "\n";
+    std::cout << "values per Node: " << myIntList.nodeCapacity() << ", Node size: "
+              << sizeof(decltype(myIntList)::Node) << " B\n";
+
+    assert(testappendprepend<100>() && "Failed to append and prepend correctly");
+    assert((testsplitmerge<1, 500>()) && "Failed to split and merge single value Nodes");
+    assert((testsplitmerge<4, 2000>()) && "Failed to split and merge small Nodes");
+    assert((testsplitmerge<16, 2000>()) && "Failed to split and merge large Nodes");
+    assert(testcopyreverse<100>() && "Failed to copy and reverse correctly");
+    assert(testiterators<100>() && "Failed to iterate correctly");
+    assert(testmoves<100>() && "Failed to move values and lists");
+    assert(testrawslots<1000>() && "Failed to keep only live values in the slots");
+
+    std::cout << "All tests succeeded.\n";
+}